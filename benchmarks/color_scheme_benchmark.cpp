@@ -0,0 +1,65 @@
+// Measures dynamic color scheme generation: cold (palettes solved from the
+// seed) versus memoized lookups, as done when switching tenants or modes.
+
+#include "raym3/styles/ColorScheme.h"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace raym3;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double ElapsedUs(Clock::time_point start) {
+  return std::chrono::duration<double, std::micro>(Clock::now() - start)
+      .count();
+}
+
+} // namespace
+
+int main() {
+  std::vector<Color> seeds;
+  for (int i = 0; i < 64; ++i) {
+    seeds.push_back({(unsigned char)(i * 37), (unsigned char)(i * 91 + 40),
+                     (unsigned char)(i * 53 + 90), 255});
+  }
+
+  // Cold: every seed's palettes are solved from scratch
+  ColorScheme::ClearSeedCache();
+  auto start = Clock::now();
+  unsigned checksum = 0;
+  for (Color seed : seeds) {
+    checksum += ColorScheme::FromSeed(seed, false).primary.r;
+  }
+  double coldLightUs = ElapsedUs(start);
+
+  // Dark after light reuses the palettes; only new tones are solved
+  start = Clock::now();
+  for (Color seed : seeds) {
+    checksum += ColorScheme::FromSeed(seed, true).primary.r;
+  }
+  double coldDarkUs = ElapsedUs(start);
+
+  // Warm: tenant and mode switches hit the scheme cache
+  const int rounds = 1000;
+  start = Clock::now();
+  for (int r = 0; r < rounds; ++r) {
+    for (Color seed : seeds) {
+      checksum += ColorScheme::FromSeed(seed, r & 1).primary.r;
+    }
+  }
+  double warmUs = ElapsedUs(start);
+
+  size_t count = seeds.size();
+  std::printf("seeds: %zu\n", count);
+  std::printf("cold light scheme:        %9.2f us/scheme\n",
+              coldLightUs / count);
+  std::printf("cold dark (palettes hot): %9.2f us/scheme\n",
+              coldDarkUs / count);
+  std::printf("cached lookup:            %9.3f us/scheme\n",
+              warmUs / (count * rounds));
+  std::printf("(checksum %u)\n", checksum);
+  return 0;
+}
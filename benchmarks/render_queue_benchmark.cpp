@@ -0,0 +1,154 @@
+// Measures render queue ordering and dispatch: commands are recorded
+// through RenderQueue with a no-op callback and drawn by ExecuteRenderQueue
+// (packed keys, radix sort), against the former std::stable_sort over
+// command structs holding a std::function.
+
+#include "raym3/input/RenderQueue.h"
+#include "raym3/layout/Layout.h"
+#include <raylib.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <vector>
+
+using namespace raym3;
+
+#if RAYM3_USE_INPUT_LAYERS
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Layout of a queued command before the POD command buffer
+struct LegacyCommand {
+  std::function<void(Rectangle)> renderFunc;
+  Rectangle bounds;
+  unsigned layoutId;
+  unsigned clipId;
+  int layerId;
+  int zOrder;
+  int type;
+  bool consumesInput;
+  int registrationOrder;
+};
+
+double ElapsedUs(Clock::time_point start) {
+  return std::chrono::duration<double, std::micro>(Clock::now() - start)
+      .count();
+}
+
+template <typename Fn> double BestOf(int runs, Fn &&fn) {
+  double best = 1e30;
+  for (int i = 0; i < runs; ++i) {
+    best = std::min(best, fn());
+  }
+  return best;
+}
+
+// Records one frame through the shipped queue. Layer ids start at 1, as 0
+// means "current layer"; order, if given, receives the draw order.
+void RecordFrame(const std::vector<int> &layers, std::vector<int> *order) {
+  RenderQueue::BeginFrame();
+  Layout::Begin({0, 0, 1280, 720});
+  for (int i = 0; i < (int)layers.size(); ++i) {
+    if (order) {
+      RenderQueue::RegisterCallback(
+          ComponentType::Custom,
+          [order, i](Rectangle) { order->push_back(i); }, layers[i] + 1,
+          false);
+    } else {
+      RenderQueue::RegisterCallback(
+          ComponentType::Custom, [](Rectangle) {}, layers[i] + 1, false);
+    }
+  }
+  Layout::End();
+}
+
+void Run(int commandCount, int layerCount) {
+  std::mt19937 rng(1234);
+  std::vector<int> layers(commandCount);
+  for (int &layer : layers) {
+    layer = static_cast<int>(rng() % layerCount);
+  }
+
+  const int runs = 10;
+  std::vector<LegacyCommand> legacy;
+  auto recordLegacy = [&](std::vector<int> *order) {
+    legacy.clear();
+    for (int i = 0; i < commandCount; ++i) {
+      LegacyCommand cmd = {};
+      if (order) {
+        cmd.renderFunc = [order, i](Rectangle) { order->push_back(i); };
+      } else {
+        cmd.renderFunc = [](Rectangle) {};
+      }
+      cmd.zOrder = cmd.layerId = layers[i] + 1;
+      cmd.registrationOrder = i;
+      legacy.push_back(std::move(cmd));
+    }
+  };
+  auto executeLegacy = [&] {
+    std::stable_sort(legacy.begin(), legacy.end(),
+                     [](const LegacyCommand &a, const LegacyCommand &b) {
+                       if (a.zOrder != b.zOrder)
+                         return a.zOrder < b.zOrder;
+                       return a.registrationOrder < b.registrationOrder;
+                     });
+    for (const LegacyCommand &cmd : legacy) {
+      cmd.renderFunc(cmd.bounds);
+    }
+  };
+
+  double legacyUs = BestOf(runs, [&] {
+    recordLegacy(nullptr);
+    auto start = Clock::now();
+    executeLegacy();
+    return ElapsedUs(start);
+  });
+
+  double shippedUs = BestOf(runs, [&] {
+    RecordFrame(layers, nullptr);
+    auto start = Clock::now();
+    RenderQueue::ExecuteRenderQueue();
+    return ElapsedUs(start);
+  });
+
+  // Both paths must draw in the same order
+  std::vector<int> legacyOrder, shippedOrder;
+  legacyOrder.reserve(commandCount);
+  shippedOrder.reserve(commandCount);
+  recordLegacy(&legacyOrder);
+  executeLegacy();
+  RecordFrame(layers, &shippedOrder);
+  RenderQueue::ExecuteRenderQueue();
+  RenderQueue::Clear();
+  bool ordered = legacyOrder == shippedOrder;
+
+  std::printf("%7d commands, %2d layers: stable_sort %9.1f us | "
+              "ExecuteRenderQueue %9.1f us%s\n",
+              commandCount, layerCount, legacyUs, shippedUs,
+              ordered ? "" : "  ORDER MISMATCH");
+}
+
+} // namespace
+
+int main() {
+  RenderQueue::Initialize();
+  for (int count : {10000, 100000}) {
+    for (int layers : {4, 32}) {
+      Run(count, layers);
+    }
+  }
+  return 0;
+}
+
+#else
+
+int main() {
+  std::printf("render queue benchmark needs RAYM3_USE_INPUT_LAYERS\n");
+  return 0;
+}
+
+#endif
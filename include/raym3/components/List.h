@@ -24,4 +24,30 @@ typedef std::function<void(ListItem*, int)> ListSelectionCallback;
 void List(Rectangle bounds, ListItem *items, int itemCount,
           float *outHeight = nullptr, ListSelectionCallback onSelectionChange = nullptr);
 
+// Returns the row at the given top-level index (may return nullptr to skip)
+typedef std::function<ListItem*(int)> ListRowProvider;
+typedef std::function<float(int)> ListRowHeightProvider;
+
+struct VirtualListOptions {
+  float rowHeight = 48.0f; // Default row height, also used for child rows
+  int overscan = 4;        // Rows touched above and below the visible area
+  // Optional per top-level row height. Heights are cached in a prefix-sum
+  // table until itemCount or version changes.
+  ListRowHeightProvider rowHeightProvider = nullptr;
+  // Bump when rows change outside the list (e.g. expanded toggled in code)
+  unsigned int version = 0;
+  // Keys the cached heights, hashed against the current ID scope like
+  // Layout::GetId. Lists sharing a scope need distinct ids (or PushId).
+  const char *id = "##VirtualList";
+};
+
+// Virtualized list: only rows intersecting the active scissor (plus
+// overscan) are requested from rowProvider, drawn and hit-tested, so the
+// per-frame cost does not depend on itemCount. Expanded children are
+// included. Lists are identified by options.id within the current ID scope.
+void VirtualList(Rectangle bounds, int itemCount, ListRowProvider rowProvider,
+                 float *outHeight = nullptr,
+                 ListSelectionCallback onSelectionChange = nullptr,
+                 const VirtualListOptions &options = VirtualListOptions());
+
 } // namespace raym3
@@ -12,6 +12,13 @@ public:
                      FontWeight weight = FontWeight::Regular,
                      TextAlignment alignment = TextAlignment::Left,
                      int selectionStart = -1, int selectionEnd = -1);
+
+  // Multi-line text wrapped to bounds.width, drawn from the top of bounds.
+  // Returns the laid-out size so callers can size their containers.
+  static Vector2 RenderWrapped(const char *text, Rectangle bounds,
+                               float fontSize, Color color = BLANK,
+                               FontWeight weight = FontWeight::Regular,
+                               const TextLayoutOptions &options = {});
 };
 
 } // namespace raym3
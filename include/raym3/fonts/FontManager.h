@@ -1,9 +1,11 @@
 #pragma once
 
 #include "raym3/types.h"
+#include <cstdint>
 #include <raylib.h>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace raym3 {
 
@@ -25,21 +27,62 @@ struct FontKeyHash {
   }
 };
 
+struct FontCacheStats {
+  int pages = 0;            // Shared glyph pages across all weights
+  int sizes = 0;            // Rasterized size buckets
+  int glyphs = 0;           // Glyphs across all buckets
+  size_t residentBytes = 0; // GPU memory held by glyph pages
+};
+
+struct FontPrewarmRequest {
+  FontWeight weight;
+  int size;
+};
+
 class FontManager {
 public:
   static void Initialize();
   static void Shutdown();
 
+  // Returns a font for the nearest size bucket at or above size, living on a
+  // glyph page shared by its weight; draw it at the exact size and raylib
+  // scales it. Owned by FontManager, freed on Shutdown.
   static Font LoadFont(FontWeight weight = FontWeight::Regular,
                        FontStyle style = FontStyle::Normal, int size = 16);
   static Font LoadCustomFont(const std::string &path, int size);
 
   static void UnloadFont(Font font);
 
+  // Rasterizes glyphs for any codepoints of text the bucket does not have
+  // yet (only ASCII is baked up front). Returns true if glyphs were added,
+  // in which case previously returned Fonts are stale and must be fetched
+  // again with LoadFont.
+  static bool RequestGlyphs(FontWeight weight, int size, const char *text);
+
+  // Fonts searched in order for codepoints Roboto lacks (e.g. CJK). The
+  // memory variant does not copy; data must outlive the FontManager.
+  static bool AddFallbackFont(const std::string &path);
+  static void AddFallbackFontFromMemory(const unsigned char *data,
+                                        int dataSize);
+
+  // Changes whenever glyph tables or page textures change, for caches that
+  // hold Font copies or glyph metrics
+  static uint32_t GetGlyphGeneration();
+
+  // Builds the given sizes up front: glyphs are rasterized on workerCount
+  // threads (0 = hardware concurrency) and uploaded on the calling thread,
+  // which must own the GL context. Sizes already resident are skipped.
+  static void PrewarmFonts(const std::vector<FontPrewarmRequest> &fonts,
+                           int workerCount = 0);
+
+  static FontCacheStats GetCacheStats();
+
   static Font GetDefaultFont() { return defaultFont_; }
 
 private:
   static Font LoadRobotoFont(FontWeight weight, FontStyle style, int size);
+  static void RefreshFontCopies();
+  static void ForgetMissingGlyphs();
   static std::unordered_map<FontKey, Font, FontKeyHash> fontCache_;
   static Font defaultFont_;
   static bool initialized_;
@@ -4,11 +4,36 @@
 #define RAYM3_USE_INPUT_LAYERS 0
 #endif
 
+#include <cstddef>
+#include <cstdint>
 #include <raylib.h>
 #include <vector>
 
 namespace raym3 {
 
+// Per-frame counters for blocking-region queries
+struct InputQueryStats {
+  uint32_t queries = 0;     // ShouldProcessMouseInput/IsBlockedByHigherLayer
+  uint32_t regionTests = 0; // Point-in-rectangle tests against regions
+  size_t regions = 0;       // Active blocking regions
+};
+
+// Slot 0 is the mouse, the rest are touches
+constexpr int kMaxPointers = 11;
+
+// An active pointer as resolved at BeginFrame against the previous frame's
+// blocking regions. A touch keeps its slot while the finger stays down.
+struct PointerState {
+  int touchId = -1; // raylib touch point id, -1 for the mouse
+  Vector2 position = {0, 0};
+  bool active = false;
+  bool down = false;
+  bool pressed = false;  // Went down this frame
+  bool released = false; // Lifted this frame; position is where it lifted
+  int topLayer = -1;     // Highest blocking layer under it, -1 if none
+  int targetRegion = -1; // Registration order of that region, -1 if none
+};
+
 #if RAYM3_USE_INPUT_LAYERS
 
 struct BlockingRegion {
@@ -59,6 +84,26 @@ public:
   // Input consumption
   static void ConsumeInput();
 
+  // Multi-pointer input. Pointers are bit indices into the returned masks.
+  static PointerState GetPointer(int pointer);
+  static uint32_t GetActivePointers();
+  // Pointers inside bounds and not blocked by a higher layer
+  static uint32_t GetPointersOver(Rectangle bounds, int layerId = -1);
+  // Same test for pointers released this frame (a click or tap)
+  static uint32_t GetPointersReleasedOver(Rectangle bounds, int layerId = -1);
+  // Per-pointer counterpart of BeginInputCapture: captures a pointer that
+  // went down inside bounds this frame; true while this widget holds it.
+  // On the press frame a later (inner) widget takes the capture over.
+  static bool BeginPointerCapture(int pointer, Rectangle bounds,
+                                  int layerId = -1);
+  static bool IsPointerCapturedBy(int pointer, Rectangle bounds,
+                                  int layerId = -1);
+  static uint32_t GetPointersCapturedBy(Rectangle bounds, int layerId = -1);
+  static void ReleasePointerCapture(int pointer);
+
+  // Counters of the last completed frame
+  static InputQueryStats GetQueryStats();
+
 private:
   static std::vector<BlockingRegion> blockingRegions_;
   static std::vector<BlockingRegion>
@@ -66,7 +111,18 @@ private:
   static int currentLayerId_;
   static std::vector<int> layerStack_;
   static int registrationOrder_;
-  static InputCapture currentCapture_;
+  // Slot 0 (the mouse) backs the single-pointer capture API
+  static InputCapture pointerCaptures_[kMaxPointers];
+  static PointerState pointers_[kMaxPointers];
+  static uint32_t activePointers_;
+  static InputQueryStats frameStats_;
+  static InputQueryStats lastFrameStats_;
+
+  static void ResolvePointers();
+  static void ResolveTarget(PointerState &pointer);
+  static int TopBlockingLayerAt(Vector2 point);
+  static bool SameCapture(const InputCapture &capture, Rectangle bounds,
+                          int layerId);
 };
 
 #else // RAYM3_USE_INPUT_LAYERS == 0
@@ -93,6 +149,35 @@ public:
   }
   static bool IsBlockedByHigherLayer(int, Vector2) { return false; }
   static void ConsumeInput() {}
+  static PointerState GetPointer(int pointer) {
+    PointerState state;
+    if (pointer == 0) {
+      state.active = true;
+      state.position = GetMousePosition();
+      state.down = IsMouseButtonDown(MOUSE_BUTTON_LEFT);
+      state.pressed = IsMouseButtonPressed(MOUSE_BUTTON_LEFT);
+      state.released = IsMouseButtonReleased(MOUSE_BUTTON_LEFT);
+    }
+    return state;
+  }
+  static uint32_t GetActivePointers() { return 1u; }
+  static uint32_t GetPointersOver(Rectangle bounds, int = -1) {
+    return CheckCollisionPointRec(GetMousePosition(), bounds) ? 1u : 0u;
+  }
+  static uint32_t GetPointersReleasedOver(Rectangle bounds, int = -1) {
+    return IsMouseButtonReleased(MOUSE_BUTTON_LEFT) &&
+                   CheckCollisionPointRec(GetMousePosition(), bounds)
+               ? 1u
+               : 0u;
+  }
+  static bool BeginPointerCapture(int pointer, Rectangle bounds, int = -1) {
+    return pointer == 0 && IsMouseButtonPressed(MOUSE_BUTTON_LEFT) &&
+           CheckCollisionPointRec(GetMousePosition(), bounds);
+  }
+  static bool IsPointerCapturedBy(int, Rectangle, int = -1) { return false; }
+  static uint32_t GetPointersCapturedBy(Rectangle, int = -1) { return 0u; }
+  static void ReleasePointerCapture(int) {}
+  static InputQueryStats GetQueryStats() { return {}; }
 };
 
 #endif // RAYM3_USE_INPUT_LAYERS
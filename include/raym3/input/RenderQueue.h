@@ -4,8 +4,15 @@
 #define RAYM3_USE_INPUT_LAYERS 0
 #endif
 
+#include "raym3/layout/Layout.h"
+#include "raym3/types.h"
 #include <raylib.h>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace raym3 {
@@ -24,16 +31,51 @@ enum class ComponentType {
   Custom
 };
 
+// What ExecuteRenderQueue draws for a command
+enum class RenderCommandKind : uint8_t {
+  RoundedRect, // Fill, or outline when lineWidth > 0
+  Text,
+  Icon,
+  Callback // Custom drawing, see RegisterCallback
+};
+
+// Fixed-size POD command. Strings and callables live in the queue's frame
+// arena, so recording a frame does not touch the heap once warmed up.
 struct RenderCommand {
-  std::function<void()> renderFunc;
   Rectangle bounds;
+  LayoutId layoutId; // Node allocated for this component
+  LayoutId clipId;   // Enclosing scroll container, 0 if none
   int layerId;
   int zOrder;
+  int registrationOrder; // Also the command's index in the queue
   ComponentType type;
+  RenderCommandKind kind;
   bool consumesInput;
-  int registrationOrder;
+  Color color;
+  union {
+    struct {
+      float cornerRadius;
+      float lineWidth;
+    } rect;
+    struct {
+      const char *text;
+      float fontSize;
+      FontWeight weight;
+    } text;
+    struct {
+      const char *name;
+      IconVariation variation;
+    } icon;
+    struct {
+      void (*invoke)(void *callable, Rectangle bounds);
+      void (*destroy)(void *callable); // nullptr if trivially destructible
+      void *callable;
+    } callback;
+  };
 };
 
+static_assert(std::is_trivially_copyable_v<RenderCommand>);
+
 class RenderQueue {
 public:
   static void Initialize();
@@ -46,25 +88,72 @@ public:
   static void PopLayer();
   static int GetCurrentLayerId();
   
-  // Component registration
-  static Rectangle RegisterComponent(
-      ComponentType type,
-      std::function<void(Rectangle)> renderFunc,
-      int layerId = 0,
-      bool consumesInput = true);
+  // Component registration. Each call allocates a layout node and returns
+  // its bounds; the command is drawn by ExecuteRenderQueue.
+  static Rectangle RegisterRoundedRect(ComponentType type, Color color,
+                                       float cornerRadius,
+                                       float lineWidth = 0.0f,
+                                       int layerId = 0,
+                                       bool consumesInput = true);
+  // text is copied
+  static Rectangle RegisterText(const char *text, float fontSize, Color color,
+                                FontWeight weight = FontWeight::Regular,
+                                int layerId = 0);
+  static Rectangle RegisterIcon(const char *name, Color color,
+                                IconVariation variation = IconVariation::Filled,
+                                int layerId = 0);
+  // Escape hatch for custom drawing: fn(Rectangle) is moved into the frame
+  // arena, so a lambda is recorded without a heap allocation
+  template <typename Fn>
+  static Rectangle RegisterCallback(ComponentType type, Fn &&fn,
+                                    int layerId = 0,
+                                    bool consumesInput = true) {
+    using Callable = std::decay_t<Fn>;
+    // FrameArena aligns offsets within max_align_t-aligned blocks
+    static_assert(alignof(Callable) <= alignof(std::max_align_t),
+                  "over-aligned callables are not supported");
+    void *storage = AllocateFrame(sizeof(Callable), alignof(Callable));
+    RenderCommand &cmd =
+        Record(type, RenderCommandKind::Callback, layerId, consumesInput);
+    cmd.callback.callable = new (storage) Callable(std::forward<Fn>(fn));
+    cmd.callback.invoke = [](void *callable, Rectangle bounds) {
+      (*static_cast<Callable *>(callable))(bounds);
+    };
+    cmd.callback.destroy = nullptr;
+    if constexpr (!std::is_trivially_destructible_v<Callable>) {
+      cmd.callback.destroy = [](void *callable) {
+        static_cast<Callable *>(callable)->~Callable();
+      };
+    }
+    return cmd.bounds;
+  }
+  // Same as RegisterCallback; kept for existing callers
+  template <typename Fn>
+  static Rectangle RegisterComponent(ComponentType type, Fn &&renderFunc,
+                                     int layerId = 0,
+                                     bool consumesInput = true) {
+    return RegisterCallback(type, std::forward<Fn>(renderFunc), layerId,
+                            consumesInput);
+  }
   
   // Check if a bounds should receive input
   static bool ShouldReceiveInput(Rectangle bounds, int layerId);
 
 private:
   static std::vector<RenderCommand> renderQueue_;
+  static std::vector<uint64_t> sortKeys_;
   static int currentLayerId_;
   static std::vector<int> layerStack_;
   static int registrationCounter_;
   static int nextComponentId_;
   static std::vector<int> inputBlockingLayers_;
   
+  static void *AllocateFrame(size_t size, size_t align);
+  static RenderCommand &Record(ComponentType type, RenderCommandKind kind,
+                               int layerId, bool consumesInput);
+  static void Execute(const RenderCommand &cmd);
   static void BuildInputBlockingMap();
+  static void ResolveBounds();
 };
 
 #else // RAYM3_USE_INPUT_LAYERS == 0
@@ -83,7 +172,27 @@ public:
   static void PushLayer(int = 0) {}
   static void PopLayer() {}
   static int GetCurrentLayerId() { return 0; }
-  static Rectangle RegisterComponent(ComponentType, std::function<void(Rectangle)>, int = 0, bool = true) {
+  static Rectangle RegisterRoundedRect(ComponentType, Color, float,
+                                       float = 0.0f, int = 0, bool = true) {
+    return {0, 0, 0, 0};
+  }
+  static Rectangle RegisterText(const char *, float, Color,
+                                FontWeight = FontWeight::Regular, int = 0) {
+    return {0, 0, 0, 0};
+  }
+  static Rectangle RegisterIcon(const char *, Color,
+                                IconVariation = IconVariation::Filled,
+                                int = 0) {
+    return {0, 0, 0, 0};
+  }
+  template <typename Fn>
+  static Rectangle RegisterCallback(ComponentType, Fn &&, int = 0,
+                                    bool = true) {
+    return {0, 0, 0, 0};
+  }
+  template <typename Fn>
+  static Rectangle RegisterComponent(ComponentType, Fn &&, int = 0,
+                                     bool = true) {
     return {0, 0, 0, 0};
   }
   static bool ShouldReceiveInput(Rectangle, int) { return true; }
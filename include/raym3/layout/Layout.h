@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <raylib.h>
 #include <vector>
@@ -10,6 +11,9 @@
 
 namespace raym3 {
 
+// Hashed identifier of a layout node (FNV-1a chained through the ID stack)
+using LayoutId = uint32_t;
+
 struct LayoutStyle {
   float width = -1.0f; // -1 means auto/undefined
   float height = -1.0f;
@@ -24,6 +28,15 @@ struct LayoutStyle {
   int justify = 0;   // 0: Start, 1: Center, 2: End, 3: SpaceBetween...
   int align = 0;     // 0: Auto, 1: FlexStart, 2: Center, 3: FlexEnd, 4: Stretch
   int flexWrap = 0;  // 0: NoWrap, 1: Wrap, 2: WrapReverse
+
+  bool operator==(const LayoutStyle &) const = default;
+};
+
+// Node bookkeeping for the retained Yoga tree, reset by Layout::Begin
+struct LayoutFrameStats {
+  int nodesReused = 0;  // Nodes recycled from the previous frame
+  int nodesCreated = 0; // Nodes allocated with YGNodeNew this frame
+  int nodesDirtied = 0; // Reused nodes whose style or parent changed
 };
 
 class Layout {
@@ -65,12 +78,52 @@ public:
   // Returns screen bounds if no scroll container is active
   static Rectangle GetActiveScissorBounds();
 
+  // ID stack. Every node is keyed by a hash of its parent's ID and its index
+  // among the siblings of the current scope, so a conditional widget only
+  // shifts the siblings declared after it in the same container. Wrap
+  // optional or reorderable subtrees in PushId/PopId to make their bounds and
+  // scroll state fully independent of surrounding call order.
+  static void PushId(const char *strId);
+  static void PushId(const void *ptrId);
+  static void PushId(int intId);
+  static void PopId();
+
+  // Hash a key against the current ID scope without pushing it
+  static LayoutId GetId(const char *strId);
+
   // Helpers
   static LayoutStyle Row();
   static LayoutStyle Column();
   static LayoutStyle Flex(float grow = 1.0f);
   static LayoutStyle Fixed(float width, float height);
 
+  // Retained tree mode (default on): Yoga nodes are recycled by layout ID
+  // and only restyled when their LayoutStyle changes, so Yoga can reuse
+  // cached measurements for untouched subtrees. Disable to rebuild the whole
+  // tree every frame.
+  static void SetRetainedTree(bool enabled);
+  static bool IsRetainedTree();
+
+  // Counters for the current (or last completed) frame
+  static LayoutFrameStats GetFrameStats();
+
+  // Same-frame resolution (default off): components registered through
+  // RenderQueue::RegisterComponent are replayed after Layout::End with the
+  // bounds calculated this frame instead of the previous frame's, removing
+  // the one-frame lag on resize and on newly shown panels.
+  static void SetSameFrameResolve(bool enabled);
+  static bool IsSameFrameResolve();
+
+  // ID of the node most recently declared by Alloc or a Begin*Container call
+  static LayoutId GetLastId();
+
+  // ID of the innermost open scroll container, 0 if none
+  static LayoutId GetScrollContainerId();
+
+  // Bounds stored for id by the most recent Layout::End ({0,0,0,0} if the
+  // node has not been laid out yet)
+  static Rectangle GetBounds(LayoutId id);
+
   // Debug visualization
   static void SetDebug(bool enabled);
   static void DrawDebug();
@@ -28,6 +28,10 @@ void PopLayer();
 
 void SetTheme(bool darkMode);
 bool IsDarkMode();
+// Crossfade duration for SetTheme/SetSeedColor; 0 (default) is instant
+void SetThemeTransition(float seconds);
+// Material dynamic color from a brand color; applies to both modes
+void SetSeedColor(Color seedColor);
 
 void BeginContainer(Rectangle bounds,
                     LayoutDirection direction = LayoutDirection::Column);
@@ -74,6 +78,9 @@ void Icon(const char *name, Rectangle bounds,
 void Text(const char *text, Rectangle bounds, float fontSize, Color color,
           FontWeight weight = FontWeight::Regular,
           TextAlignment alignment = TextAlignment::Left);
+// Word-wrapped to bounds.width; returns the laid-out size
+Vector2 Text(const char *text, Rectangle bounds, float fontSize, Color color,
+             FontWeight weight, const TextLayoutOptions &options);
 
 void Card(Rectangle bounds, CardVariant variant = CardVariant::Elevated);
 bool Dialog(const char *title, const char *message, const char *buttons);
@@ -3,9 +3,36 @@
 #include <raylib.h>
 #include "raym3/types.h"
 #include "raym3/styles/Theme.h"
+#include <cstddef>
+#include <cstdint>
 
 namespace raym3 {
 
+// Counters for the MeasureText cache
+struct TextMeasureStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    size_t entries = 0; // Cached (font, string) measurements
+    size_t fonts = 0;   // Fonts with a glyph advance table
+};
+
+// Cumulative advances of a single-line string, one entry per codepoint
+// boundary: x[i] is the width of the first i codepoints and byteOffsets[i]
+// the byte where codepoint i starts (x[0] = 0, byteOffsets[count] = length)
+struct TextAdvances {
+    const float* x = nullptr;
+    const int* byteOffsets = nullptr;
+    int count = 0; // Codepoints
+
+    float Width() const { return x ? x[count] : 0.0f; }
+    // Advance at a byte offset, snapped down to a codepoint boundary
+    float XAtByte(int byteOffset) const;
+    // Byte offset of the boundary closest to targetX (caret hit testing)
+    int ByteAtX(float targetX) const;
+    // Number of leading codepoints that fit in maxWidth
+    int FitCount(float maxWidth) const;
+};
+
 class Renderer {
 public:
     static void DrawRoundedRectangle(Rectangle bounds, float cornerRadius, Color color);
@@ -15,7 +42,38 @@ public:
     static void DrawText(const char* text, Vector2 position, float fontSize, Color color, FontWeight weight = FontWeight::Regular);
     static void DrawTextCentered(const char* text, Rectangle bounds, float fontSize, Color color, FontWeight weight = FontWeight::Regular);
     
+    // Cached by (font, string); misses are summed from a per-font advance
+    // table instead of walking the font's glyph tables
     static Vector2 MeasureText(const char* text, float fontSize, FontWeight weight = FontWeight::Regular);
+    // Prefix advances in one pass, cached per string. The returned arrays
+    // stay valid until the next GetTextAdvances call, including across text
+    // draws and measurements that load glyphs (which clear the other caches)
+    static TextAdvances GetTextAdvances(const char* text, float fontSize, FontWeight weight = FontWeight::Regular);
+    static TextMeasureStats GetTextMeasureStats();
+    // Must be called when fonts are unloaded (done by raym3::Shutdown)
+    static void ClearTextMeasureCache();
+    
+    // Rounded rectangles, outlines and SDF icons are single quads drawn under
+    // a shape shader. By default each draw binds it and restores raylib's
+    // default shader afterwards. Between BeginShapeBatch and EndShapeBatch it
+    // stays bound, so consecutive shapes share one draw call; raylib drawing
+    // in between is unaffected, but don't open a batch inside your own
+    // BeginShaderMode, as EndShapeBatch leaves the default shader active.
+    // raym3 batches the layer render queue itself.
+    static void BeginShapeBatch();
+    static void EndShapeBatch();
+    // Unbinds the shape shader for drawing that needs the default shader
+    // (3D scenes); the batch stays open and the next shape rebinds it
+    static void SuspendShapeBatch();
+    // false falls back to tessellated raylib shapes
+    static void SetSdfShapes(bool enabled);
+    static bool IsSdfShapes();
+    // Draws a distance field texture (alpha 0.5 on the edge) in the same
+    // batch as the shapes; false if the shape shader is unavailable
+    static bool DrawDistanceField(Texture2D texture, Rectangle source,
+                                  Rectangle dest, float smoothing, Color color);
+    // Releases the shape shader and text caches (done by raym3::Shutdown)
+    static void Shutdown();
     
 private:
     static void DrawShadow(Rectangle bounds, float cornerRadius, int elevation);
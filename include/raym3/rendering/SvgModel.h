@@ -7,6 +7,9 @@ struct NSVGimage;
 
 namespace raym3 {
 
+struct IconPack;
+struct IconPackEntry;
+
 class SvgModel {
 public:
   SvgModel();
@@ -14,6 +17,8 @@ public:
 
   bool LoadFromFile(const char *filename);
   bool LoadFromString(const char *data);
+  // Rebuilds a pre-parsed icon from an embedded icon pack (no XML parsing)
+  bool LoadFromPack(const IconPack &pack, const IconPackEntry &entry);
   void Unload();
 
   NSVGimage *GetImage() const { return image; }
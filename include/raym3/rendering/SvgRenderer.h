@@ -1,12 +1,43 @@
 #pragma once
 
 #include "raym3/types.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <raylib.h>
 #include <string>
-#include <unordered_map>
 
 namespace raym3 {
 
+class SvgModel;
+
+struct IconCacheStats {
+  int pages = 0;            // Atlas pages currently allocated
+  int icons = 0;            // Cached icon sizes (atlas and standalone)
+  float occupancy = 0.0f;   // Packed icon area / total page area (0..1)
+  uint64_t hits = 0;        // Draws served from the cache
+  uint64_t misses = 0;      // Draws that had to rasterize (or queue)
+  uint64_t evictions = 0;   // Icons dropped to make room
+  size_t residentBytes = 0; // GPU memory held by pages and textures
+};
+
+struct IconCacheLimits {
+  // Upper bound on GPU memory used by icons. Least recently used
+  // standalone textures are evicted first; the number of atlas pages is
+  // capped so they fit as well.
+  size_t maxBytes = 32u * 1024u * 1024u;
+  int maxAtlasPages = 4; // 1024x1024 RGBA (4 MiB) each
+};
+
+struct IconLoaderOptions {
+  // Parse and rasterize cache misses on worker threads instead of the
+  // render thread. Icons draw nothing (or a placeholder) until uploaded.
+  bool async = false;
+  int workerCount = 2;
+  int uploadsPerFrame = 8;      // Finished icons uploaded per frame
+  bool drawPlaceholder = false; // Faint rounded rect while loading
+};
+
 class SvgRenderer {
 public:
   static void Initialize(const char *basePath);
@@ -16,18 +47,75 @@ public:
                        IconVariation variation = IconVariation::Filled,
                        Color color = BLACK);
 
+  // Draws the icon from a signed distance field generated once per
+  // (name, variation) at a fixed reference size, so every size (including
+  // animated ones) shares one texture and no per-size cache entries are
+  // created. Edges stay crisp when scaled; fine detail is slightly softer
+  // than a bitmap icon at small sizes.
+  static void DrawIconSdf(const char *name, Rectangle bounds,
+                          IconVariation variation = IconVariation::Filled,
+                          Color color = BLACK);
+
+  // When enabled, DrawIcon renders through DrawIconSdf
+  static void SetSdfMode(bool enabled);
+  static bool IsSdfMode();
+
   // Helper to get the variation folder name
   static const char *GetVariationFolder(IconVariation variation);
 
+  // Rasterized icons are shelf-packed into shared atlas pages so that
+  // consecutive DrawIcon calls batch into a single draw call. When all
+  // pages are full, the least recently used page is cleared and repacked.
+  // Counters accumulate until Shutdown.
+  static IconCacheStats GetCacheStats();
+
+  static void SetCacheLimits(const IconCacheLimits &limits);
+  static const IconCacheLimits &GetCacheLimits();
+
+  // Configure synchronous or background icon loading. Changing options
+  // restarts the worker pool and drops icons still in flight. Workers are
+  // joined by Shutdown, which must run before the program exits.
+  static void SetLoaderOptions(const IconLoaderOptions &options);
+  static const IconLoaderOptions &GetLoaderOptions();
+
+  // Uploads icons finished by the workers, up to uploadsPerFrame.
+  // Called by raym3::BeginFrame.
+  static void ProcessPendingUploads();
+
 private:
   static std::string basePath;
-  static std::unordered_map<std::string, Texture2D> textureCache;
   static bool autoDetected;
 
-  static std::string GetCacheKey(const char *name, IconVariation variation,
-                                 int width, int height);
-  static Texture2D LoadSvgTexture(const char *name, IconVariation variation,
-                                  int width, int height);
+  // Compact key from the interned icon name, variation and size
+  static uint64_t GetCacheKey(const char *name, IconVariation variation,
+                              int width, int height, bool sdf = false);
+  // Returns the parsed SVG for (name, variation), loading it on first use.
+  // Missing icons are remembered and return nullptr without touching the
+  // filesystem again.
+  // Thread-safe.
+  static std::shared_ptr<SvgModel> GetSvgModel(const char *name,
+                                               IconVariation variation);
+  // Rasterizes to a white RGBA image (alpha only carries the shape) so it
+  // can be tinted at draw time, surrounded by a transparent border of
+  // padding pixels. The pixels live in a scratch buffer owned by the
+  // renderer and stay valid until the next call; do not unload the image.
+  // Returns an image with data == nullptr on failure.
+  static Image RasterizeSvg(const char *name, IconVariation variation,
+                            int width, int height, int padding = 0);
+
+  // Draws key from the atlas or standalone cache; false if not resident
+  static bool DrawCachedIcon(uint64_t key, Vector2 position, Color color);
+  // Uploads a rasterized icon (with a border of padding pixels) into the
+  // atlas, or into its own texture when padding is 0
+  static void StoreRasterizedIcon(uint64_t key, const Image &image,
+                                  int padding);
+
+  // Distance field texture for an icon (id == 0 if it could not be loaded)
+  static Texture2D GetSdfTexture(const char *name, IconVariation variation);
+
+  static void RunIconWorker();
+  static void StartIconWorkers(int count);
+  static void StopIconWorkers();
 };
 
 } // namespace raym3
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "raym3/types.h"
+#include <cstdint>
+#include <raylib.h>
+#include <string>
+#include <vector>
+
+namespace raym3 {
+
+struct TextLayoutGlyph {
+  int codepoint;
+  Vector2 position; // Relative to the layout's top-left corner
+};
+
+struct TextLayoutLine {
+  int firstGlyph;
+  int glyphCount;
+  int byteStart; // Source text range shown on this line
+  int byteEnd;
+  float width;
+};
+
+struct TextLayoutResult {
+  std::vector<TextLayoutGlyph> glyphs;
+  std::vector<TextLayoutLine> lines;
+  Vector2 size = {0, 0};
+  float lineHeight = 0.0f;
+  float fontSize = 0.0f;
+  FontWeight weight = FontWeight::Regular;
+  bool truncated = false; // Lines were dropped by maxLines
+  // What was laid out; cache hits are confirmed against these
+  std::string text;
+  float maxWidth = 0.0f;
+  TextLayoutOptions options;
+};
+
+struct TextLayoutStats {
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+  size_t entries = 0;
+};
+
+// Word-wrapping paragraph layout. Results are cached by (text, width, font,
+// options), so an unchanged paragraph costs one hash lookup and a compare
+// per frame.
+class TextLayout {
+public:
+  // Breaks text into lines no wider than maxWidth (0 = no wrapping) at
+  // spaces, or inside a word that does not fit on a line by itself; '\n'
+  // always breaks. The result stays valid until the next Layout call.
+  static const TextLayoutResult &Layout(const char *text, float maxWidth,
+                                        float fontSize, FontWeight weight,
+                                        const TextLayoutOptions &options = {});
+  static void Draw(const TextLayoutResult &layout, Vector2 origin,
+                   Color color);
+
+  static TextLayoutStats GetStats();
+  static void ClearCache();
+};
+
+} // namespace raym3
@@ -1,15 +1,108 @@
 #pragma once
 
 #include "raym3/types.h"
+#include <cstddef>
+#include <cstdint>
 #include <raylib.h>
+#include <string_view>
 
 namespace raym3 {
 
+// One entry per ColorScheme color, in member order
+enum class ColorRole : uint8_t {
+  Primary,
+  OnPrimary,
+  PrimaryContainer,
+  OnPrimaryContainer,
+  Secondary,
+  OnSecondary,
+  SecondaryContainer,
+  OnSecondaryContainer,
+  Tertiary,
+  OnTertiary,
+  TertiaryContainer,
+  OnTertiaryContainer,
+  Error,
+  OnError,
+  ErrorContainer,
+  OnErrorContainer,
+  Surface,
+  OnSurface,
+  SurfaceVariant,
+  OnSurfaceVariant,
+  SurfaceContainerLowest,
+  SurfaceContainerLow,
+  SurfaceContainer,
+  SurfaceContainerHigh,
+  SurfaceContainerHighest,
+  Outline,
+  OutlineVariant,
+  Shadow,
+  Scrim,
+  InverseSurface,
+  InverseOnSurface,
+  InversePrimary,
+  Count
+};
+
+inline constexpr size_t kColorRoleCount = static_cast<size_t>(ColorRole::Count);
+
+// Role names as used by Theme::GetColor(const char *)
+inline constexpr const char *kColorRoleNames[kColorRoleCount] = {
+    "primary",
+    "onPrimary",
+    "primaryContainer",
+    "onPrimaryContainer",
+    "secondary",
+    "onSecondary",
+    "secondaryContainer",
+    "onSecondaryContainer",
+    "tertiary",
+    "onTertiary",
+    "tertiaryContainer",
+    "onTertiaryContainer",
+    "error",
+    "onError",
+    "errorContainer",
+    "onErrorContainer",
+    "surface",
+    "onSurface",
+    "surfaceVariant",
+    "onSurfaceVariant",
+    "surfaceContainerLowest",
+    "surfaceContainerLow",
+    "surfaceContainer",
+    "surfaceContainerHigh",
+    "surfaceContainerHighest",
+    "outline",
+    "outlineVariant",
+    "shadow",
+    "scrim",
+    "inverseSurface",
+    "inverseOnSurface",
+    "inversePrimary",
+};
+
+// Resolves a role name at compile time; an unknown name fails to compile:
+//   Theme::GetColor(ColorRoleFromName("onSurface"))
+consteval ColorRole ColorRoleFromName(std::string_view name) {
+  for (size_t i = 0; i < kColorRoleCount; ++i) {
+    if (name == kColorRoleNames[i])
+      return static_cast<ColorRole>(i);
+  }
+  throw "unknown color role";
+}
+
 class ColorScheme {
 public:
   static ColorScheme Light();
   static ColorScheme Dark();
+  // Material dynamic color: HCT tonal palettes from the seed, memoized per
+  // seed so repeated calls (tenant or light/dark switches) are lookups
   static ColorScheme FromSeed(Color seedColor, bool darkMode);
+  static void ClearSeedCache();
+
+  Color Get(ColorRole role) const;
 
   Color primary;
   Color onPrimary;
@@ -51,4 +144,43 @@ private:
   static Color AdjustLightness(Color color, float factor);
 };
 
+inline constexpr Color ColorScheme::*kColorRoleMembers[kColorRoleCount] = {
+    &ColorScheme::primary,
+    &ColorScheme::onPrimary,
+    &ColorScheme::primaryContainer,
+    &ColorScheme::onPrimaryContainer,
+    &ColorScheme::secondary,
+    &ColorScheme::onSecondary,
+    &ColorScheme::secondaryContainer,
+    &ColorScheme::onSecondaryContainer,
+    &ColorScheme::tertiary,
+    &ColorScheme::onTertiary,
+    &ColorScheme::tertiaryContainer,
+    &ColorScheme::onTertiaryContainer,
+    &ColorScheme::error,
+    &ColorScheme::onError,
+    &ColorScheme::errorContainer,
+    &ColorScheme::onErrorContainer,
+    &ColorScheme::surface,
+    &ColorScheme::onSurface,
+    &ColorScheme::surfaceVariant,
+    &ColorScheme::onSurfaceVariant,
+    &ColorScheme::surfaceContainerLowest,
+    &ColorScheme::surfaceContainerLow,
+    &ColorScheme::surfaceContainer,
+    &ColorScheme::surfaceContainerHigh,
+    &ColorScheme::surfaceContainerHighest,
+    &ColorScheme::outline,
+    &ColorScheme::outlineVariant,
+    &ColorScheme::shadow,
+    &ColorScheme::scrim,
+    &ColorScheme::inverseSurface,
+    &ColorScheme::inverseOnSurface,
+    &ColorScheme::inversePrimary,
+};
+
+inline Color ColorScheme::Get(ColorRole role) const {
+  return this->*kColorRoleMembers[static_cast<size_t>(role)];
+}
+
 } // namespace raym3
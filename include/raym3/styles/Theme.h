@@ -14,26 +14,49 @@ public:
     
     static void SetDarkMode(bool darkMode);
     static bool IsDarkMode();
+    // Derives the scheme from a brand color (see ColorScheme::FromSeed);
+    // SetDarkMode keeps using the seed until ClearSeedColor
+    static void SetSeedColor(Color seedColor);
+    static void ClearSeedColor();
+    
+    // Scheme changes crossfade over this many seconds (0, the default,
+    // switches instantly). GetColorScheme returns the blended scheme.
+    static void SetTransitionDuration(float seconds);
+    static float GetTransitionDuration();
+    static bool IsTransitioning();
+    // Advances a running crossfade; called once per frame by BeginFrame
+    static void UpdateTransition(float deltaTime);
     
     static ColorScheme& GetColorScheme();
     static TypographyScale& GetTypographyScale();
     static ShapeTokens& GetShapeTokens();
     
+    // Single indexed load; use ColorRoleFromName for a checked name
+    static Color GetColor(ColorRole role) { return colorScheme_.Get(role); }
+    // Runtime name lookup, falls back to surface for unknown names
     static Color GetColor(const char* role);
     static Color GetStateLayerColor(Color baseColor, ComponentState state);
     
     static Font GetFont(float size, FontWeight weight = FontWeight::Regular, FontStyle style = FontStyle::Normal);
+    // Builds every typography scale size for the weights components use, so
+    // no font is built mid-frame. Called by Initialize.
+    static void PrewarmFonts(int workerCount = 0);
     
     static float GetElevationShadow(int elevation);
     static Color GetElevationColor(int elevation);
     
 private:
     static ColorScheme colorScheme_;
+    static float transitionDuration_;
+    static float transitionElapsed_;
     static TypographyScale typographyScale_;
     static ShapeTokens shapeTokens_;
     static bool darkMode_;
+    static bool hasSeedColor_;
+    static Color seedColor_;
     static bool initialized_;
     
+    static void ApplyScheme(const ColorScheme& target);
     static void InitializeTypographyScale();
     static void InitializeShapeTokens();
 };
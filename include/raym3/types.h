@@ -60,6 +60,13 @@ struct ShapeTokens {
   float cornerExtraLarge;
 };
 
+struct TextLayoutOptions {
+  TextAlignment alignment = TextAlignment::Left;
+  int maxLines = 0;        // 0 = unlimited
+  bool ellipsis = true;    // End the last line with "..." when text is cut
+  float lineHeight = 0.0f; // 0 = 1.2 * fontSize
+};
+
 struct ButtonOptions {
   Color backgroundColor = {0, 0, 0, 0};
   Color outlineColor = {0, 0, 0, 0};
@@ -15,8 +15,6 @@ bool ButtonComponent::Render(const char *text, Rectangle bounds,
                              ButtonVariant variant,
                              const ButtonOptions &options) {
   // Interaction
-  Vector2 mousePos = GetMousePosition();
-
 #if RAYM3_USE_INPUT_LAYERS
   // Get the current layer ID (buttons should be on the same layer as their
   // parent)
@@ -29,20 +27,32 @@ bool ButtonComponent::Render(const char *text, Rectangle bounds,
                        ? true
                        : Layout::IsRectVisibleInScrollContainer(bounds);
 
-  bool canProcessInput =
-      isVisible &&
-      InputLayerManager::ShouldProcessMouseInput(bounds, buttonLayerId);
-  bool isHovered = canProcessInput && CheckCollisionPointRec(mousePos, bounds);
+  // Bit 0 is the mouse; any touch held over the button presses it and one
+  // lifted over it clicks
+  uint32_t over =
+      isVisible ? InputLayerManager::GetPointersOver(bounds, buttonLayerId)
+                : 0u;
+  uint32_t released =
+      isVisible
+          ? InputLayerManager::GetPointersReleasedOver(bounds, buttonLayerId)
+          : 0u;
+  bool isHovered = (over & 1u) != 0;
+  bool isPressed =
+      (isHovered && IsMouseButtonDown(MOUSE_BUTTON_LEFT)) || (over & ~1u) != 0;
+  bool isReleased = released != 0;
 #else
+  Vector2 mousePos = GetMousePosition();
   bool isVisible = Layout::IsRectVisibleInScrollContainer(bounds);
   bool isHovered = isVisible && CheckCollisionPointRec(mousePos, bounds);
-#endif
   bool isPressed = isHovered && IsMouseButtonDown(MOUSE_BUTTON_LEFT);
+  bool isReleased = isHovered && IsMouseButtonReleased(MOUSE_BUTTON_LEFT);
+#endif
 
   // Modal check
   if (DialogComponent::IsActive() && !DialogComponent::IsRendering()) {
     isHovered = false;
     isPressed = false;
+    isReleased = false;
   }
 
   ComponentState state = GetState(bounds);
@@ -123,7 +133,7 @@ bool ButtonComponent::Render(const char *text, Rectangle bounds,
 
   // Fix: Check for release independently of current frame's "Pressed" state
   // (which requires mouse down)
-  bool wasClicked = isHovered && IsMouseButtonReleased(MOUSE_BUTTON_LEFT);
+  bool wasClicked = isReleased;
 
 #if RAYM3_USE_INPUT_LAYERS
   if (isHovered || wasClicked) {
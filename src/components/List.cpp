@@ -4,7 +4,11 @@
 #include "raym3/rendering/Renderer.h"
 #include "raym3/rendering/SvgRenderer.h"
 #include "raym3/styles/Theme.h"
+#include "layout/LayoutIdMap.h"
+#include <algorithm>
 #include <raylib.h>
+#include <unordered_map>
+#include <vector>
 
 #if RAYM3_USE_INPUT_LAYERS
 #include "raym3/input/InputLayer.h"
@@ -14,164 +18,171 @@ namespace raym3 {
 
 static ListSelectionCallback s_selectionCallback = nullptr;
 
-static float RenderListItems(Rectangle bounds, ListItem *items, int itemCount,
-                             int depth, float currentY) {
-  if (!items || itemCount <= 0)
-    return currentY;
-
+// Draws a single row and handles its hover, selection and expand input.
+// index is the row's position among its siblings (passed to the selection
+// callback).
+static void RenderListRow(ListItem &item, int index, Rectangle itemBounds,
+                          int depth, bool isVisible) {
 #if RAYM3_USE_INPUT_LAYERS
   int listLayerId = InputLayerManager::GetCurrentLayerId();
 #endif
 
   ColorScheme &scheme = Theme::GetColorScheme();
-  float itemHeight = 48.0f;
+  float itemHeight = itemBounds.height;
   float indentPerLevel = 16.0f;
   float basePadding = 16.0f;
 
-  for (int i = 0; i < itemCount; ++i) {
-    ListItem &item = items[i];
-
-    Rectangle itemBounds = {bounds.x, currentY, bounds.width, itemHeight};
-
-    bool isVisible = Layout::IsRectVisibleInScrollContainer(itemBounds);
-
-    Vector2 mousePos = GetMousePosition();
+  Vector2 mousePos = GetMousePosition();
 #if RAYM3_USE_INPUT_LAYERS
-    bool canProcessInput =
-        isVisible &&
-        InputLayerManager::ShouldProcessMouseInput(itemBounds, listLayerId);
-    bool isHovered =
-        canProcessInput && CheckCollisionPointRec(mousePos, itemBounds);
+  bool canProcessInput =
+      isVisible &&
+      InputLayerManager::ShouldProcessMouseInput(itemBounds, listLayerId);
+  bool isHovered =
+      canProcessInput && CheckCollisionPointRec(mousePos, itemBounds);
 #else
-    bool isHovered = isVisible && CheckCollisionPointRec(mousePos, itemBounds);
+  bool isHovered = isVisible && CheckCollisionPointRec(mousePos, itemBounds);
 #endif
-    bool isPressed = isHovered && IsMouseButtonDown(MOUSE_BUTTON_LEFT);
-    bool isClicked = isHovered && IsMouseButtonReleased(MOUSE_BUTTON_LEFT);
+  bool isPressed = isHovered && IsMouseButtonDown(MOUSE_BUTTON_LEFT);
+  bool isClicked = isHovered && IsMouseButtonReleased(MOUSE_BUTTON_LEFT);
+
+  ComponentState state = ComponentState::Default;
+  if (item.disabled) {
+    state = ComponentState::Disabled;
+  } else if (isPressed) {
+    state = ComponentState::Pressed;
+  } else if (isHovered) {
+    state = ComponentState::Hovered;
+  }
 
-    ComponentState state = ComponentState::Default;
-    if (item.disabled) {
-      state = ComponentState::Disabled;
-    } else if (isPressed) {
-      state = ComponentState::Pressed;
-    } else if (isHovered) {
-      state = ComponentState::Hovered;
+  if (isVisible) {
+    if (item.selected) {
+      Renderer::DrawRoundedRectangle(itemBounds,
+                                     Theme::GetShapeTokens().cornerSmall,
+                                     scheme.secondaryContainer);
+    } else if (item.backgroundColor.a > 0) {
+      Renderer::DrawRoundedRectangle(itemBounds,
+                                     Theme::GetShapeTokens().cornerSmall,
+                                     item.backgroundColor);
     }
 
-    if (isVisible) {
-      if (item.selected) {
-        Renderer::DrawRoundedRectangle(itemBounds,
-                                       Theme::GetShapeTokens().cornerSmall,
-                                       scheme.secondaryContainer);
-      } else if (item.backgroundColor.a > 0) {
-        Renderer::DrawRoundedRectangle(itemBounds,
-                                       Theme::GetShapeTokens().cornerSmall,
-                                       item.backgroundColor);
-      }
+    if (!item.disabled) {
+      Color stateBaseColor =
+          item.selected ? scheme.onSecondaryContainer : scheme.onSurface;
+      if (item.textColor.a > 0)
+        stateBaseColor = item.textColor;
 
-      if (!item.disabled) {
-        Color stateBaseColor =
-            item.selected ? scheme.onSecondaryContainer : scheme.onSurface;
-        if (item.textColor.a > 0)
-          stateBaseColor = item.textColor;
+      Renderer::DrawStateLayer(itemBounds, Theme::GetShapeTokens().cornerSmall,
+                               stateBaseColor, state);
+    }
 
-        Renderer::DrawStateLayer(itemBounds,
-                                 Theme::GetShapeTokens().cornerSmall,
-                                 stateBaseColor, state);
-      }
+    float contentX = itemBounds.x + basePadding + (depth * indentPerLevel);
+    float centerY = itemBounds.y + itemHeight / 2.0f;
 
-      float contentX = itemBounds.x + basePadding + (depth * indentPerLevel);
-      float centerY = itemBounds.y + itemHeight / 2.0f;
+    Color contentColor =
+        item.selected ? scheme.onSecondaryContainer : scheme.onSurface;
+    if (item.disabled) {
+      contentColor = ColorAlpha(contentColor, 0.38f);
+    } else {
+      if (item.textColor.a > 0)
+        contentColor = item.textColor;
+    }
 
-      Color contentColor =
-          item.selected ? scheme.onSecondaryContainer : scheme.onSurface;
-      if (item.disabled) {
-        contentColor = ColorAlpha(contentColor, 0.38f);
-      } else {
-        if (item.textColor.a > 0)
-          contentColor = item.textColor;
-      }
+    if (item.leadingIcon) {
+      Rectangle iconRect = {contentX, centerY - 12.0f, 24.0f, 24.0f};
+      Color currentIconColor = contentColor;
+      if (!item.disabled && item.iconColor.a > 0)
+        currentIconColor = item.iconColor;
 
-      if (item.leadingIcon) {
-        Rectangle iconRect = {contentX, centerY - 12.0f, 24.0f, 24.0f};
-        Color currentIconColor = contentColor;
-        if (!item.disabled && item.iconColor.a > 0)
-          currentIconColor = item.iconColor;
+      SvgRenderer::DrawIcon(item.leadingIcon, iconRect, IconVariation::Filled,
+                            currentIconColor);
+      contentX += 24.0f + 16.0f;
+    }
 
-        SvgRenderer::DrawIcon(item.leadingIcon, iconRect, IconVariation::Filled,
-                              currentIconColor);
-        contentX += 24.0f + 16.0f;
-      }
+    if (item.text) {
+      Vector2 textPos = {contentX, centerY - 7.0f};
+      Renderer::DrawText(item.text, textPos, 14.0f, contentColor,
+                         FontWeight::Regular);
+    }
 
-      if (item.text) {
-        Vector2 textPos = {contentX, centerY - 7.0f};
-        Renderer::DrawText(item.text, textPos, 14.0f, contentColor,
-                           FontWeight::Regular);
+    if (item.secondaryActionIcon || (item.childCount > 0)) {
+      const char *iconName = item.secondaryActionIcon;
+      if (!iconName && item.childCount > 0) {
+        iconName = item.expanded ? "expand_less" : "expand_more";
       }
 
-      if (item.secondaryActionIcon || (item.childCount > 0)) {
-        const char *iconName = item.secondaryActionIcon;
-        if (!iconName && item.childCount > 0) {
-          iconName = item.expanded ? "expand_less" : "expand_more";
-        }
-
-        if (iconName) {
-          float iconSize = 24.0f;
-          float buttonSize = 48.0f;
-          Rectangle actionBounds = {itemBounds.x + itemBounds.width -
-                                        buttonSize,
-                                    itemBounds.y, buttonSize, buttonSize};
+      if (iconName) {
+        float iconSize = 24.0f;
+        float buttonSize = 48.0f;
+        Rectangle actionBounds = {itemBounds.x + itemBounds.width - buttonSize,
+                                  centerY - buttonSize / 2.0f, buttonSize,
+                                  buttonSize};
 
 #if RAYM3_USE_INPUT_LAYERS
-          bool actionCanProcessInput =
-              isVisible && InputLayerManager::ShouldProcessMouseInput(
-                               actionBounds, listLayerId);
-          bool actionHovered = actionCanProcessInput &&
-                               CheckCollisionPointRec(mousePos, actionBounds);
+        bool actionCanProcessInput =
+            isVisible && InputLayerManager::ShouldProcessMouseInput(
+                             actionBounds, listLayerId);
+        bool actionHovered = actionCanProcessInput &&
+                             CheckCollisionPointRec(mousePos, actionBounds);
 #else
-          bool actionHovered =
-              isVisible && CheckCollisionPointRec(mousePos, actionBounds);
+        bool actionHovered =
+            isVisible && CheckCollisionPointRec(mousePos, actionBounds);
 #endif
-          bool actionClicked =
-              actionHovered && IsMouseButtonReleased(MOUSE_BUTTON_LEFT);
+        bool actionClicked =
+            actionHovered && IsMouseButtonReleased(MOUSE_BUTTON_LEFT);
 
-          Rectangle iconRect = {actionBounds.x + (buttonSize - iconSize) / 2.0f,
-                                actionBounds.y + (buttonSize - iconSize) / 2.0f,
-                                iconSize, iconSize};
+        Rectangle iconRect = {actionBounds.x + (buttonSize - iconSize) / 2.0f,
+                              actionBounds.y + (buttonSize - iconSize) / 2.0f,
+                              iconSize, iconSize};
 
-          if (actionHovered && !item.disabled) {
-            Renderer::DrawStateLayer(actionBounds, 24.0f, contentColor,
-                                     ComponentState::Hovered);
-          }
+        if (actionHovered && !item.disabled) {
+          Renderer::DrawStateLayer(actionBounds, 24.0f, contentColor,
+                                   ComponentState::Hovered);
+        }
 
-          SvgRenderer::DrawIcon(iconName, iconRect, IconVariation::Filled,
-                                contentColor);
+        SvgRenderer::DrawIcon(iconName, iconRect, IconVariation::Filled,
+                              contentColor);
 
-          if (actionClicked && !item.disabled) {
-            if (item.childCount > 0) {
-              item.expanded = !item.expanded;
-            }
-            isClicked = false;
+        if (actionClicked && !item.disabled) {
+          if (item.childCount > 0) {
+            item.expanded = !item.expanded;
           }
+          isClicked = false;
         }
       }
     }
+  }
 
-    if (isClicked && !item.disabled) {
+  if (isClicked && !item.disabled) {
 #if RAYM3_USE_INPUT_LAYERS
-      InputLayerManager::ConsumeInput();
+    InputLayerManager::ConsumeInput();
 #endif
-      if (s_selectionCallback) {
-        s_selectionCallback(&item, i);
-      } else {
-        item.selected = !item.selected;
-      }
+    if (s_selectionCallback) {
+      s_selectionCallback(&item, index);
+    } else {
+      item.selected = !item.selected;
     }
+  }
 
 #if RAYM3_USE_INPUT_LAYERS
-    if (isHovered || isPressed) {
-      InputLayerManager::RegisterBlockingRegion(itemBounds, true);
-    }
+  if (isHovered || isPressed) {
+    InputLayerManager::RegisterBlockingRegion(itemBounds, true);
+  }
 #endif
+}
+
+static float RenderListItems(Rectangle bounds, ListItem *items, int itemCount,
+                             int depth, float currentY) {
+  if (!items || itemCount <= 0)
+    return currentY;
+
+  float itemHeight = 48.0f;
+
+  for (int i = 0; i < itemCount; ++i) {
+    ListItem &item = items[i];
+
+    Rectangle itemBounds = {bounds.x, currentY, bounds.width, itemHeight};
+    bool isVisible = Layout::IsRectVisibleInScrollContainer(itemBounds);
+    RenderListRow(item, i, itemBounds, depth, isVisible);
 
     currentY += itemHeight;
 
@@ -198,4 +209,224 @@ void List(Rectangle bounds, ListItem *items, int itemCount, float *outHeight,
   s_selectionCallback = nullptr;
 }
 
+// Prefix sums over the children of one expanded node, keyed by its children
+// array. spans[i] is the height of child i including its expanded subtree.
+struct ChildSpans {
+  int childCount = 0;
+  std::vector<float> spans;
+  std::vector<float> offsets; // childCount + 1 entries
+};
+
+// Per-list cache for VirtualList. spanHeights[i] is the height of top-level
+// row i including its expanded children; offsets is its prefix sum, so the
+// first visible row is found by binary search instead of a linear walk.
+struct VirtualListState {
+  int itemCount = 0;
+  unsigned int version = 0;
+  float rowHeight = 0.0f;
+  bool variableHeight = false;
+  std::vector<float> spanHeights;
+  std::vector<float> offsets; // itemCount + 1 entries
+  std::unordered_map<const ListItem *, ChildSpans> childSpans;
+};
+
+// Keyed by the hashed list id, so a list shown conditionally never hands
+// its cached heights to another list
+static LayoutIdMap<VirtualListState> s_virtualLists;
+
+static void RebuildOffsets(std::vector<float> &offsets,
+                           const std::vector<float> &spans, int from) {
+  int count = (int)spans.size();
+  offsets.resize(count + 1);
+  if (from <= 0) {
+    offsets[0] = 0.0f;
+    from = 0;
+  }
+  for (int i = from; i < count; ++i) {
+    offsets[i + 1] = offsets[i] + spans[i];
+  }
+}
+
+static ChildSpans &GetChildSpans(VirtualListState &state,
+                                 const ListItem &item);
+
+// Total height of the expanded subtree below an item (not the item itself)
+static float ChildrenHeight(VirtualListState &state, const ListItem &item) {
+  if (!item.expanded || !item.children || item.childCount <= 0)
+    return 0.0f;
+  return GetChildSpans(state, item).offsets.back();
+}
+
+// Cached child spans of an item, measured the first time it is expanded
+static ChildSpans &GetChildSpans(VirtualListState &state,
+                                 const ListItem &item) {
+  ChildSpans &cache = state.childSpans[item.children];
+  if (cache.childCount != item.childCount || cache.offsets.empty()) {
+    cache.childCount = item.childCount;
+    cache.spans.resize(item.childCount);
+    for (int i = 0; i < item.childCount; ++i) {
+      cache.spans[i] =
+          state.rowHeight + ChildrenHeight(state, item.children[i]);
+    }
+    RebuildOffsets(cache.offsets, cache.spans, 0);
+  }
+  return cache;
+}
+
+// Renders expanded children starting at startY. The first child reaching
+// top is found by binary search and the walk stops at bottom; children past
+// it are covered by the cached prefix sums. Returns the subtree's end Y.
+static float RenderVisibleChildren(VirtualListState &state, Rectangle bounds,
+                                   ListItem &parent, int depth, float startY,
+                                   float top, float bottom) {
+  if (!parent.expanded || !parent.children || parent.childCount <= 0)
+    return startY;
+
+  ChildSpans &cache = GetChildSpans(state, parent);
+  float rowHeight = state.rowHeight;
+  int first = (int)(std::upper_bound(cache.offsets.begin(),
+                                     cache.offsets.end(), top - startY) -
+                    cache.offsets.begin()) -
+              1;
+  first = std::clamp(first, 0, parent.childCount - 1);
+
+  int dirtyFrom = parent.childCount;
+  float currentY = startY + cache.offsets[first];
+  for (int i = first; i < parent.childCount; ++i) {
+    if (currentY >= bottom)
+      break;
+
+    ListItem &child = parent.children[i];
+    Rectangle rowBounds = {bounds.x, currentY, bounds.width, rowHeight};
+    bool isVisible = currentY + rowHeight > top;
+    RenderListRow(child, i, rowBounds, depth, isVisible);
+    float endY = RenderVisibleChildren(state, bounds, child, depth + 1,
+                                       currentY + rowHeight, top, bottom);
+
+    // Expansion toggled somewhere in this child's subtree
+    float span = endY - currentY;
+    if (span != cache.spans[i]) {
+      cache.spans[i] = span;
+      dirtyFrom = std::min(dirtyFrom, i);
+    }
+    currentY = endY;
+  }
+
+  if (dirtyFrom < parent.childCount) {
+    RebuildOffsets(cache.offsets, cache.spans, dirtyFrom);
+  }
+  return startY + cache.offsets[parent.childCount];
+}
+
+void VirtualList(Rectangle bounds, int itemCount, ListRowProvider rowProvider,
+                 float *outHeight, ListSelectionCallback onSelectionChange,
+                 const VirtualListOptions &options) {
+  const char *name = options.id ? options.id : "##VirtualList";
+  LayoutId listId = Layout::GetId(name);
+  if (listId == 0) {
+    listId = HashLayoutId(name, 0); // No ID scopes without Yoga
+  }
+  VirtualListState &state = s_virtualLists[listId];
+
+  if (itemCount < 0)
+    itemCount = 0;
+  float rowHeight = options.rowHeight;
+  auto topLevelHeight = [&](int index) {
+    return options.rowHeightProvider ? options.rowHeightProvider(index)
+                                     : rowHeight;
+  };
+  auto spanHeight = [&](int index) {
+    ListItem *item = rowProvider ? rowProvider(index) : nullptr;
+    float height = topLevelHeight(index);
+    return item ? height + ChildrenHeight(state, *item) : height;
+  };
+
+  // Rebuild the height cache only when the data set changes. Appending rows
+  // (e.g. a growing log) only measures the new rows.
+  bool variableHeight = (bool)options.rowHeightProvider;
+  bool reset = state.offsets.empty() || state.version != options.version ||
+               state.rowHeight != rowHeight ||
+               state.variableHeight != variableHeight;
+  if (reset) {
+    state.itemCount = 0;
+    state.version = options.version;
+    state.rowHeight = rowHeight;
+    state.variableHeight = variableHeight;
+    state.childSpans.clear();
+  }
+  if (reset || state.itemCount != itemCount) {
+    int firstNew = std::min(state.itemCount, itemCount);
+    state.spanHeights.resize(itemCount);
+    for (int i = firstNew; i < itemCount; ++i) {
+      state.spanHeights[i] = spanHeight(i);
+    }
+    state.itemCount = itemCount;
+    RebuildOffsets(state.offsets, state.spanHeights, firstNew);
+  }
+
+#if RAYM3_USE_INPUT_LAYERS
+  InputLayerManager::RegisterBlockingRegion(bounds, true);
+#endif
+
+  // Visible range in screen space: the active scissor, further limited to
+  // the list's own bounds when it has a height
+  Rectangle clip = Layout::GetActiveScissorBounds();
+  float top = clip.y;
+  float bottom = clip.y + clip.height;
+  if (bounds.height > 0) {
+    top = std::max(top, bounds.y);
+    bottom = std::min(bottom, bounds.y + bounds.height);
+  }
+
+  if (itemCount > 0 && bottom > top && rowProvider) {
+    // Binary search the prefix sums for the first and last visible rows
+    float localTop = top - bounds.y;
+    float localBottom = bottom - bounds.y;
+    int first = (int)(std::upper_bound(state.offsets.begin(),
+                                       state.offsets.end(), localTop) -
+                      state.offsets.begin()) -
+                1;
+    int last = (int)(std::lower_bound(state.offsets.begin(),
+                                      state.offsets.end(), localBottom) -
+                     state.offsets.begin()) -
+               1;
+    first = std::clamp(first - options.overscan, 0, itemCount - 1);
+    last = std::clamp(last + options.overscan, 0, itemCount - 1);
+
+    s_selectionCallback = onSelectionChange;
+    int dirtyFrom = itemCount;
+    float currentY = bounds.y + state.offsets[first];
+    for (int i = first; i <= last; ++i) {
+      float rowStart = currentY;
+      float height = topLevelHeight(i);
+      ListItem *item = rowProvider(i);
+      if (item) {
+        Rectangle rowBounds = {bounds.x, currentY, bounds.width, height};
+        bool isVisible = currentY + height > top && currentY < bottom;
+        RenderListRow(*item, i, rowBounds, 0, isVisible);
+        currentY = RenderVisibleChildren(state, bounds, *item, 1,
+                                         currentY + height, top, bottom);
+      } else {
+        currentY += height;
+      }
+
+      // Expansion toggled (here or by the app for a visible row)
+      float span = currentY - rowStart;
+      if (span != state.spanHeights[i]) {
+        state.spanHeights[i] = span;
+        dirtyFrom = std::min(dirtyFrom, i);
+      }
+    }
+    s_selectionCallback = nullptr;
+
+    if (dirtyFrom < itemCount) {
+      RebuildOffsets(state.offsets, state.spanHeights, dirtyFrom);
+    }
+  }
+
+  if (outHeight) {
+    *outHeight = state.offsets[itemCount];
+  }
+}
+
 } // namespace raym3
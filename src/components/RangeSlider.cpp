@@ -9,13 +9,21 @@
 
 #if RAYM3_USE_INPUT_LAYERS
 #include "raym3/input/InputLayer.h"
+#include <bit>
 #endif
 
 namespace raym3 {
 
 // Static state for immediate mode tracking
+#if RAYM3_USE_INPUT_LAYERS
+// Thumb held by each pointer slot while the pointer is captured by a slider
+static int dragThumb_[kMaxPointers] = {};
+constexpr int kMaxThumbDrags = kMaxPointers;
+#else
 static int activeFieldId_ = -1;
 static int activeThumbIndex_ = -1;
+constexpr int kMaxThumbDrags = 1;
+#endif
 static int currentFieldId_ = 0;
 
 void RangeSliderComponent::ResetFieldId() { currentFieldId_ = 0; }
@@ -58,92 +66,104 @@ RangeSliderComponent::Render(Rectangle bounds, const std::vector<float> &values,
   // Check interaction
   bool inputBlocked =
       DialogComponent::IsActive() && !DialogComponent::IsRendering();
-  int fieldId = currentFieldId_++;
-  bool isDraggingThis = (activeFieldId_ == fieldId);
 
-  Vector2 mousePos = GetMousePosition();
   Rectangle hitRect = {trackBounds.x, trackBounds.y - 15, trackBounds.width,
                        trackBounds.height + 30};
 
+  // Thumbs dragged this frame and the pointer position driving each
+  int dragThumbs[kMaxThumbDrags];
+  Vector2 dragPositions[kMaxThumbDrags];
+  int dragCount = 0;
+
 #if RAYM3_USE_INPUT_LAYERS
-  bool canProcessInput = InputLayerManager::ShouldProcessMouseInput(bounds);
-  bool mouseOverHit =
-      canProcessInput && CheckCollisionPointRec(mousePos, hitRect);
-  bool mouseDown = canProcessInput && IsMouseButtonDown(MOUSE_BUTTON_LEFT);
-  bool mousePressed =
-      canProcessInput && IsMouseButtonPressed(MOUSE_BUTTON_LEFT);
-  bool mouseReleased =
-      canProcessInput && IsMouseButtonReleased(MOUSE_BUTTON_LEFT);
+  // Each pointer (mouse or touch) pressed over the track captures the
+  // closest thumb and drags it until it lifts, so two fingers can move both
+  // thumbs (or two sliders) at once
+  Rectangle hitArea = GetCollisionRec(bounds, hitRect);
+  if (!inputBlocked) {
+    uint32_t over = InputLayerManager::GetPointersOver(hitArea) &
+                    ~InputLayerManager::GetPointersCapturedBy(hitArea);
+    for (; over; over &= over - 1) {
+      int slot = std::countr_zero(over);
+      if (InputLayerManager::BeginPointerCapture(slot, hitArea)) {
+        dragThumb_[slot] = GetClosestThumbIndex(
+            trackBounds, result, min, max,
+            InputLayerManager::GetPointer(slot).position);
+        InputLayerManager::ConsumeInput();
+      }
+    }
+  }
+  for (uint32_t captured = InputLayerManager::GetPointersCapturedBy(hitArea);
+       captured; captured &= captured - 1) {
+    int slot = std::countr_zero(captured);
+    PointerState pointer = InputLayerManager::GetPointer(slot);
+    if (inputBlocked || !pointer.down) {
+      InputLayerManager::ReleasePointerCapture(slot);
+      continue;
+    }
+    dragThumbs[dragCount] = dragThumb_[slot];
+    dragPositions[dragCount++] = pointer.position;
+  }
 #else
+  int fieldId = currentFieldId_++;
+  bool isDraggingThis = (activeFieldId_ == fieldId);
+  Vector2 mousePos = GetMousePosition();
   bool mouseOverHit = CheckCollisionPointRec(mousePos, hitRect);
   bool mouseDown = IsMouseButtonDown(MOUSE_BUTTON_LEFT);
   bool mousePressed = IsMouseButtonPressed(MOUSE_BUTTON_LEFT);
-  bool mouseReleased = IsMouseButtonReleased(MOUSE_BUTTON_LEFT);
-#endif
 
-  if (!inputBlocked) {
-    if (mousePressed && mouseOverHit) {
-      activeFieldId_ = fieldId;
-      activeThumbIndex_ =
-          GetClosestThumbIndex(trackBounds, result, min, max, mousePos);
-      isDraggingThis = true;
-#if RAYM3_USE_INPUT_LAYERS
-      InputLayerManager::ConsumeInput();
+  if (!inputBlocked && mousePressed && mouseOverHit) {
+    activeFieldId_ = fieldId;
+    activeThumbIndex_ =
+        GetClosestThumbIndex(trackBounds, result, min, max, mousePos);
+    isDraggingThis = true;
+  }
+  if (isDraggingThis && (inputBlocked || !mouseDown)) {
+    activeFieldId_ = -1;
+    activeThumbIndex_ = -1;
+    isDraggingThis = false;
+  }
+  if (isDraggingThis) {
+    dragThumbs[dragCount] = activeThumbIndex_;
+    dragPositions[dragCount++] = mousePos;
+  }
 #endif
-    }
 
-    if (mouseReleased && isDraggingThis) {
-      activeFieldId_ = -1;
-      activeThumbIndex_ = -1;
-      isDraggingThis = false;
-    }
+  for (int drag = 0; drag < dragCount; ++drag) {
+    int thumb = dragThumbs[drag];
+    if (thumb < 0 || thumb >= (int)result.size())
+      continue;
 
-    if (isDraggingThis && activeThumbIndex_ >= 0 &&
-        activeThumbIndex_ < (int)result.size()) {
-      if (mouseDown) {
-        float normalized = GetValueFromPosition(trackBounds, mousePos.x);
-        float newValue = min + normalized * (max - min);
-
-        // Discrete mode: snap to step
-        if (options.stepValue > 0.0f) {
-          newValue = std::round((newValue - min) / options.stepValue) *
-                         options.stepValue +
-                     min;
-        }
-        newValue = std::clamp(newValue, min, max);
+    float normalized = GetValueFromPosition(trackBounds, dragPositions[drag].x);
+    float newValue = min + normalized * (max - min);
+
+    // Discrete mode: snap to step
+    if (options.stepValue > 0.0f) {
+      newValue = std::round((newValue - min) / options.stepValue) *
+                     options.stepValue +
+                 min;
+    }
+    newValue = std::clamp(newValue, min, max);
 
-        // Enforce ordering: don't let thumbs cross each other
-        float minVal = (activeThumbIndex_ > 0)
-                           ? result[activeThumbIndex_ - 1] + options.minDistance
-                           : min;
-        float maxVal = (activeThumbIndex_ < (int)result.size() - 1)
-                           ? result[activeThumbIndex_ + 1] - options.minDistance
-                           : max;
-        newValue = std::clamp(newValue, minVal, maxVal);
+    // Enforce ordering: don't let thumbs cross each other
+    float minVal =
+        (thumb > 0) ? result[thumb - 1] + options.minDistance : min;
+    float maxVal = (thumb < (int)result.size() - 1)
+                       ? result[thumb + 1] - options.minDistance
+                       : max;
+    newValue = std::clamp(newValue, minVal, maxVal);
 
-        result[activeThumbIndex_] = newValue;
+    result[thumb] = newValue;
 
-        // Recalculate for drawing
-        float updatedNorm = (newValue - min) / (max - min);
-        normalizedValues[activeThumbIndex_] = updatedNorm;
-        float splitX = trackBounds.x + (trackBounds.width * updatedNorm);
-        thumbRects[activeThumbIndex_].x = splitX - thumbWidth / 2.0f;
+    // Recalculate for drawing
+    float updatedNorm = (newValue - min) / (max - min);
+    normalizedValues[thumb] = updatedNorm;
+    float splitX = trackBounds.x + (trackBounds.width * updatedNorm);
+    thumbRects[thumb].x = splitX - thumbWidth / 2.0f;
 
 #if RAYM3_USE_INPUT_LAYERS
-        InputLayerManager::ConsumeInput();
+    InputLayerManager::ConsumeInput();
 #endif
-      } else {
-        activeFieldId_ = -1;
-        activeThumbIndex_ = -1;
-        isDraggingThis = false;
-      }
-    }
-  } else {
-    if (isDraggingThis) {
-      activeFieldId_ = -1;
-      activeThumbIndex_ = -1;
-      isDraggingThis = false;
-    }
   }
 
   // Determine colors
@@ -250,17 +270,19 @@ RangeSliderComponent::Render(Rectangle bounds, const std::vector<float> &values,
   }
 
   // 6. Draw Value Indicators
-  if (isDraggingThis && options.showValueIndicators && activeThumbIndex_ >= 0 &&
-      activeThumbIndex_ < (int)result.size()) {
+  for (int drag = 0; options.showValueIndicators && drag < dragCount; ++drag) {
+    int thumb = dragThumbs[drag];
+    if (thumb < 0 || thumb >= (int)result.size())
+      continue;
     char valueStr[32];
     snprintf(valueStr, sizeof(valueStr),
              options.valueFormat ? options.valueFormat : "%.0f",
-             result[activeThumbIndex_]);
+             result[thumb]);
 
     float bubbleWidth = 48.0f;
     float bubbleHeight = 32.0f;
     float triangleHeight = 6.0f;
-    const auto &thumbRect = thumbRects[activeThumbIndex_];
+    const auto &thumbRect = thumbRects[thumb];
     float bubbleY = thumbRect.y - bubbleHeight - triangleHeight - 4.0f;
     float bubbleX = thumbRect.x + thumbRect.width / 2.0f - bubbleWidth / 2.0f;
 
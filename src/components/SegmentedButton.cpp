@@ -1,6 +1,7 @@
 #include "raym3/components/SegmentedButton.h"
 #include "raym3/components/Dialog.h"
 #include "raym3/components/Icon.h"
+#include "raym3/fonts/FontManager.h"
 #include "raym3/rendering/Renderer.h"
 #include "raym3/styles/Theme.h"
 #include <cmath>
@@ -142,6 +143,7 @@ bool SegmentedButtonComponent::Render(Rectangle bounds,
       float iconSize = 18.0f;
       float gap = 8.0f;
       // Measure text
+      FontManager::RequestGlyphs(FontWeight::Medium, 14, label);
       Font font = Theme::GetFont(14, FontWeight::Medium);
       Vector2 textSize = MeasureTextEx(font, label, 14, 1.0f);
       float totalWidth = iconSize + gap + textSize.x;
@@ -165,6 +167,7 @@ bool SegmentedButtonComponent::Render(Rectangle bounds,
                             contentColor);
     } else if (label) {
       // Text Only
+      FontManager::RequestGlyphs(FontWeight::Medium, 14, label);
       Font font = Theme::GetFont(14, FontWeight::Medium);
       Vector2 textSize = MeasureTextEx(font, label, 14, 1.0f);
       Vector2 textPos = {contentX - textSize.x / 2.0f,
@@ -9,6 +9,7 @@
 
 #if RAYM3_USE_INPUT_LAYERS
 #include "raym3/input/InputLayer.h"
+#include <bit>
 #endif
 
 namespace raym3 {
@@ -16,7 +17,7 @@ namespace raym3 {
 // Removed anonymous namespace and its static variables.
 // Moved to static member variables of SliderComponent.
 
-static int activeFieldId_ = -1;
+static int activeFieldId_ = -1; // Without input layers only one drag
 static int currentFieldId_ = 0;
 
 void SliderComponent::ResetFieldId() { currentFieldId_ = 0; }
@@ -98,43 +99,58 @@ float SliderComponent::Render(Rectangle bounds, float value, float min,
     state = ComponentState::Default;
   }
 
-  // Handle input using same logic as before...
-  int fieldId = currentFieldId_++;
-  bool isDraggingThis = (activeFieldId_ == fieldId);
-
   Vector2 mousePos = GetMousePosition();
   Rectangle hitRect = {trackBounds.x, trackBounds.y - 10, trackBounds.width,
                        trackBounds.height + 20};
 #if RAYM3_USE_INPUT_LAYERS
-  bool canProcessInput = InputLayerManager::ShouldProcessMouseInput(bounds);
-  bool mouseOverHit =
-      canProcessInput && CheckCollisionPointRec(mousePos, hitRect);
-  bool mouseDown = canProcessInput && IsMouseButtonDown(MOUSE_BUTTON_LEFT);
-  bool mousePressed =
-      canProcessInput && IsMouseButtonPressed(MOUSE_BUTTON_LEFT);
-  bool mouseReleased =
-      canProcessInput && IsMouseButtonReleased(MOUSE_BUTTON_LEFT);
+  // Each pointer (mouse or touch) is captured by the slider it pressed on
+  // and drags it until it lifts, so several sliders can move at once
+  Rectangle hitArea = GetCollisionRec(bounds, hitRect);
+  uint32_t captured = InputLayerManager::GetPointersCapturedBy(hitArea);
+  if (!captured && !inputBlocked) {
+    for (uint32_t over = InputLayerManager::GetPointersOver(hitArea); over;
+         over &= over - 1) {
+      int slot = std::countr_zero(over);
+      if (InputLayerManager::BeginPointerCapture(slot, hitArea)) {
+        captured = 1u << slot;
+        InputLayerManager::ConsumeInput();
+        break;
+      }
+    }
+  }
+  int dragPointer = captured ? std::countr_zero(captured) : 0;
+  PointerState pointer = InputLayerManager::GetPointer(dragPointer);
+  mousePos = pointer.position;
+  bool isDraggingThis = captured != 0;
+  bool mouseDown = pointer.down;
+  auto stopDrag = [&]() {
+    InputLayerManager::ReleasePointerCapture(dragPointer);
+    isDraggingThis = false;
+  };
 #else
+  int fieldId = currentFieldId_++;
+  bool isDraggingThis = (activeFieldId_ == fieldId);
   bool mouseOverHit = CheckCollisionPointRec(mousePos, hitRect);
   bool mouseDown = IsMouseButtonDown(MOUSE_BUTTON_LEFT);
   bool mousePressed = IsMouseButtonPressed(MOUSE_BUTTON_LEFT);
   bool mouseReleased = IsMouseButtonReleased(MOUSE_BUTTON_LEFT);
-#endif
+  auto stopDrag = [&]() {
+    activeFieldId_ = -1;
+    isDraggingThis = false;
+  };
 
   if (!inputBlocked) {
     if (mousePressed && mouseOverHit) {
       activeFieldId_ = fieldId;
       isDraggingThis = true;
-#if RAYM3_USE_INPUT_LAYERS
-      InputLayerManager::ConsumeInput();
-#endif
     }
-
     if (mouseReleased && isDraggingThis) {
-      activeFieldId_ = -1;
-      isDraggingThis = false;
+      stopDrag();
     }
+  }
+#endif
 
+  if (!inputBlocked) {
     if (isDraggingThis) {
       state = ComponentState::Pressed; // Override state while dragging
       if (mouseDown) {
@@ -155,16 +171,12 @@ float SliderComponent::Render(Rectangle bounds, float value, float min,
         InputLayerManager::ConsumeInput();
 #endif
       } else {
-        activeFieldId_ = -1;
-        isDraggingThis = false;
+        stopDrag();
       }
     }
-  } else {
+  } else if (isDraggingThis) {
     // Force stop dragging if blocked
-    if (isDraggingThis) {
-      activeFieldId_ = -1;
-      isDraggingThis = false;
-    }
+    stopDrag();
   }
 
   // Determine colors
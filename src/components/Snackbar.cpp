@@ -2,6 +2,7 @@
 #include "raym3/layout/Layout.h"
 #include "raym3/rendering/Renderer.h"
 #include "raym3/styles/Theme.h"
+#include <algorithm>
 #include <raylib.h>
 
 #if RAYM3_USE_INPUT_LAYERS
@@ -117,7 +118,9 @@ void SnackbarComponent::Render(Rectangle screenBounds) {
       }
       // Draw Hover Overlay
       Color hoverColor = ColorAlpha(actionColor, 0.08f);
-      DrawRectangleRounded(btnBounds, 0.5f, 4, hoverColor);
+      Renderer::DrawRoundedRectangle(
+          btnBounds, std::min(btnBounds.width, btnBounds.height) * 0.25f,
+          hoverColor);
     }
 #else
     if (isHovered) {
@@ -126,7 +129,9 @@ void SnackbarComponent::Render(Rectangle screenBounds) {
       }
       // Draw Hover Overlay
       Color hoverColor = ColorAlpha(actionColor, 0.08f);
-      DrawRectangleRounded(btnBounds, 0.5f, 4, hoverColor);
+      Renderer::DrawRoundedRectangle(
+          btnBounds, std::min(btnBounds.width, btnBounds.height) * 0.25f,
+          hoverColor);
     }
 #endif
 
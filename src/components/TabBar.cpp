@@ -35,22 +35,15 @@ static float CalcTabWidth(float availableWidth, int tabCount, float minWidth,
 //-----------------------------------------------------------------------------
 std::string TabBarComponent::TruncateText(const std::string &text,
                                           float maxWidth, float fontSize) {
-  Vector2 size = Renderer::MeasureText(text.c_str(), fontSize, FontWeight::Regular);
-  if (size.x <= maxWidth) return text;
+  TextAdvances advances = Renderer::GetTextAdvances(text.c_str(), fontSize, FontWeight::Regular);
+  if (advances.Width() <= maxWidth) return text;
 
-  std::string truncated = text;
   const std::string ellipsis = "...";
   Vector2 ellipsisSize = Renderer::MeasureText(ellipsis.c_str(), fontSize, FontWeight::Regular);
 
-  while (!truncated.empty()) {
-    truncated.pop_back();
-    Vector2 truncSize = Renderer::MeasureText(truncated.c_str(), fontSize, FontWeight::Regular);
-    if (truncSize.x + ellipsisSize.x <= maxWidth) {
-      return truncated + ellipsis;
-    }
-  }
-
-  return ellipsis;
+  // Longest codepoint prefix that still leaves room for the ellipsis
+  int fit = advances.FitCount(maxWidth - ellipsisSize.x);
+  return text.substr(0, advances.byteOffsets[fit]) + ellipsis;
 }
 
 //-----------------------------------------------------------------------------
@@ -1,5 +1,6 @@
 #include "raym3/components/Text.h"
 #include "raym3/rendering/Renderer.h"
+#include "raym3/rendering/TextLayout.h"
 #include "raym3/styles/Theme.h"
 #include <algorithm>
 #include <cstring>
@@ -60,15 +61,11 @@ void TextComponent::Render(const char *text, Rectangle bounds, float fontSize,
     if (selectionEnd > len)
       selectionEnd = len;
 
-    std::string sText = text;
-    std::string preStr = sText.substr(0, selectionStart);
-    std::string selStr =
-        sText.substr(selectionStart, selectionEnd - selectionStart);
+    TextAdvances advances = Renderer::GetTextAdvances(text, fontSize, weight);
+    float preWidth = advances.XAtByte(selectionStart);
+    float selWidth = advances.XAtByte(selectionEnd) - preWidth;
 
-    Vector2 preSize = Renderer::MeasureText(preStr.c_str(), fontSize, weight);
-    Vector2 selSize = Renderer::MeasureText(selStr.c_str(), fontSize, weight);
-
-    float selX = position.x + preSize.x;
+    float selX = position.x + preWidth;
     // Adjust for alignment if needed?
     // 'position.x' is already the start of the text drawing.
 
@@ -78,8 +75,26 @@ void TextComponent::Render(const char *text, Rectangle bounds, float fontSize,
 
     // Draw selection rect (using text height or bounds height? text lines
     // usually)
-    DrawRectangleRec({selX, position.y, selSize.x, textSize.y}, selColor);
+    DrawRectangleRec({selX, position.y, selWidth, textSize.y}, selColor);
   }
 }
 
+Vector2 TextComponent::RenderWrapped(const char *text, Rectangle bounds,
+                                     float fontSize, Color color,
+                                     FontWeight weight,
+                                     const TextLayoutOptions &options) {
+  if (!text || text[0] == '\0')
+    return {0, 0};
+
+  Color finalColor = color;
+  if (color.a == 0) {
+    finalColor = Theme::GetColorScheme().onSurface;
+  }
+
+  const TextLayoutResult &layout =
+      TextLayout::Layout(text, bounds.width, fontSize, weight, options);
+  TextLayout::Draw(layout, {bounds.x, bounds.y}, finalColor);
+  return layout.size;
+}
+
 } // namespace raym3
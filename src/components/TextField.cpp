@@ -169,16 +169,13 @@ static void DrawSelection(Rectangle bounds, const char *text, int start,
 
   ColorScheme &scheme = Theme::GetColorScheme();
 
-  std::string textBeforeStart(text, start);
-  std::string textBeforeEnd(text, end);
+  TextAdvances advances =
+      Renderer::GetTextAdvances(text, 16.0f, FontWeight::Regular);
+  float startX = advances.XAtByte(start);
+  float endX = advances.XAtByte(end);
 
-  Vector2 startSize = Renderer::MeasureText(textBeforeStart.c_str(), 16.0f,
-                                            FontWeight::Regular);
-  Vector2 endSize =
-      Renderer::MeasureText(textBeforeEnd.c_str(), 16.0f, FontWeight::Regular);
-
-  float selectionX = bounds.x + padding - scrollOffset + startSize.x;
-  float selectionWidth = endSize.x - startSize.x;
+  float selectionX = bounds.x + padding - scrollOffset + startX;
+  float selectionWidth = endX - startX;
   float selectionY = bounds.y + (bounds.height - 16.0f) / 2.0f;
   float selectionHeight = 16.0f;
 
@@ -415,17 +412,9 @@ bool TextFieldComponent::Render(char *buffer, int bufferSize, Rectangle bounds,
     int clickPosition = len;
 
     if (len > 0) {
-      float closestDiff = 10000.0f;
-      for (int i = 0; i <= len; i++) {
-        std::string sub(buffer, i);
-        Vector2 size =
-            Renderer::MeasureText(sub.c_str(), 16.0f, FontWeight::Regular);
-        float diff = std::abs(size.x - clickRelativeX);
-        if (diff < closestDiff) {
-          closestDiff = diff;
-          clickPosition = i;
-        }
-      }
+      clickPosition = Renderer::GetTextAdvances(buffer, 16.0f,
+                                                FontWeight::Regular)
+                          .ByteAtX(clickRelativeX);
     }
 
     float currentTime = GetTime();
@@ -468,17 +457,9 @@ bool TextFieldComponent::Render(char *buffer, int bufferSize, Rectangle bounds,
     int dragPosition = len;
 
     if (len > 0) {
-      float closestDiff = 10000.0f;
-      for (int i = 0; i <= len; i++) {
-        std::string sub(buffer, i);
-        Vector2 size =
-            Renderer::MeasureText(sub.c_str(), 16.0f, FontWeight::Regular);
-        float diff = std::abs(size.x - dragRelativeX);
-        if (diff < closestDiff) {
-          closestDiff = diff;
-          dragPosition = i;
-        }
-      }
+      dragPosition = Renderer::GetTextAdvances(buffer, 16.0f,
+                                               FontWeight::Regular)
+                         .ByteAtX(dragRelativeX);
     }
 
     if (fieldState.selectionStart == -1) {
@@ -554,10 +535,9 @@ bool TextFieldComponent::Render(char *buffer, int bufferSize, Rectangle bounds,
 
   // Update scroll offset if focused
   if (activeFieldId_ == fieldId) {
-    std::string textBeforeCursor(buffer, fieldState.cursorPosition);
-    Vector2 cursorSize = Renderer::MeasureText(textBeforeCursor.c_str(), 16.0f,
-                                               FontWeight::Regular);
-    float cursorX = cursorSize.x;
+    TextAdvances advances =
+        Renderer::GetTextAdvances(buffer, 16.0f, FontWeight::Regular);
+    float cursorX = advances.XAtByte(fieldState.cursorPosition);
 
     // Scroll to keep cursor in view
     if (cursorX - fieldState.scrollOffset > availableWidthForScroll) {
@@ -567,9 +547,8 @@ bool TextFieldComponent::Render(char *buffer, int bufferSize, Rectangle bounds,
     }
 
     // Clamp scroll
-    Vector2 totalSize =
-        Renderer::MeasureText(buffer, 16.0f, FontWeight::Regular);
-    float maxScroll = std::max(0.0f, totalSize.x - availableWidthForScroll);
+    float maxScroll =
+        std::max(0.0f, advances.Width() - availableWidthForScroll);
     if (fieldState.scrollOffset > maxScroll)
       fieldState.scrollOffset = maxScroll;
     if (fieldState.scrollOffset < 0)
@@ -1064,10 +1043,8 @@ void TextFieldComponent::DrawCursor(Rectangle bounds, const char *text,
       int textLen = (int)strlen(text);
       int pos = (position <= textLen) ? position : textLen;
       if (pos > 0) {
-        std::string textBeforeCursor(text, pos);
-        Vector2 textSize = Renderer::MeasureText(textBeforeCursor.c_str(),
-                                                 16.0f, FontWeight::Regular);
-        cursorX += textSize.x;
+        cursorX += Renderer::GetTextAdvances(text, 16.0f, FontWeight::Regular)
+                       .XAtByte(pos);
       }
     }
 
@@ -260,11 +260,15 @@ void TooltipManager::RenderRichTooltip(Rectangle bounds, const char *title,
     // Draw hover state
     if (isHovered) {
       Color hoverColor = ColorAlpha(scheme.primary, 0.08f);
-      DrawRectangleRounded(btnBounds, 0.5f, 4, hoverColor);
+      Renderer::DrawRoundedRectangle(
+          btnBounds, std::min(btnBounds.width, btnBounds.height) * 0.25f,
+          hoverColor);
     }
     if (isPressed) {
       Color pressColor = ColorAlpha(scheme.primary, 0.12f);
-      DrawRectangleRounded(btnBounds, 0.5f, 4, pressColor);
+      Renderer::DrawRoundedRectangle(
+          btnBounds, std::min(btnBounds.width, btnBounds.height) * 0.25f,
+          pressColor);
     }
 
     // Draw button text
@@ -1,4 +1,5 @@
 #include "raym3/components/View3D.h"
+#include "raym3/rendering/Renderer.h"
 #include <raylib.h>
 #include <rlgl.h>
 
@@ -177,7 +178,8 @@ int View3D::Render(Rectangle bounds, std::function<void()> renderCallback) {
 
   EnsureTextureSize(width, height);
 
-  // 1. Render scene to texture
+  // 1. Render scene to texture (3D batch draws need the default shader)
+  Renderer::SuspendShapeBatch();
   BeginTextureMode(target_);
   ClearBackground(BLANK); // Clear with transparent
   if (renderCallback) {
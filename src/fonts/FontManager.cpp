@@ -2,10 +2,392 @@
 #include "raym3/config.h"
 #include "EmbeddedFonts.h"
 #include <algorithm>
+#include <atomic>
+#include <cstdlib>
 #include <filesystem>
+#include <map>
+#include <rlgl.h>
+#include <thread>
+#include <unordered_set>
+#include <vector>
 
 namespace raym3 {
 
+namespace {
+
+// All sizes of a weight share glyph pages: each requested size snaps up to
+// the nearest bucket (raylib scales the bucket font to the exact size when
+// drawing), so animated or fractional sizes reuse a handful of rasterized
+// glyph sets instead of building a texture per pixel size.
+const int kSizeBuckets[] = {11, 12, 14, 16, 18, 20, 22, 24,
+                            28, 32, 36, 45, 57, 72, 96};
+constexpr int kGlyphPageWidth = 1024;
+constexpr int kInitialPageHeight = 256;
+constexpr int kMaxPageHeight = 1024; // Pages double in height up to this
+constexpr int kGlyphPadding = 2;
+constexpr int kMaxGlyphPagesPerFace = 4; // 2 MiB each at full height
+
+// Pages keep a CPU copy (gray + alpha) so they can grow: a taller texture is
+// created from it and every font on the page is repointed.
+struct GlyphPage {
+  Texture2D texture = {0};
+  int height = 0;
+  std::vector<unsigned char> pixels;
+  int shelfX = 0;
+  int shelfY = 0;
+  int shelfHeight = 0;
+};
+
+// One size bucket: a raylib Font on a shared page whose glyph table grows
+// as new codepoints are drawn
+struct GlyphBucket {
+  Font font = {0};
+  int page = 0;
+  std::unordered_set<int> codepoints; // Loaded or known to be missing
+  // Codepoints no font had. They stay out of the glyph table so raylib
+  // draws its '?' fallback for them.
+  std::vector<int> unresolved;
+};
+
+// One TTF (weights map onto the embedded faces) with its pages and buckets
+struct FontFace {
+  const unsigned char *data = nullptr;
+  unsigned int dataLen = 0;
+  std::vector<GlyphPage> pages;
+  std::map<int, GlyphBucket> buckets; // Keyed by bucket size
+};
+
+// Fonts searched, in order, for codepoints the Roboto faces lack
+struct FallbackFont {
+  std::vector<unsigned char> owned; // Empty when the caller owns the data
+  const unsigned char *data = nullptr;
+  int dataLen = 0;
+};
+
+FontFace s_regularFace;
+FontFace s_boldFace;
+std::vector<FallbackFont> s_fallbackFonts;
+
+// Bumped whenever a glyph table or page texture changes; Font copies taken
+// before that are stale
+uint32_t s_glyphGeneration = 0;
+
+FontFace &GetFace(FontWeight weight) {
+  FontFace &face = (weight == FontWeight::Bold || weight == FontWeight::Black)
+                       ? s_boldFace
+                       : s_regularFace;
+  if (!face.data) {
+    if (&face == &s_boldFace) {
+      face.data = Roboto_v3_012_hinted_static_Roboto_Bold_ttf;
+      face.dataLen = Roboto_v3_012_hinted_static_Roboto_Bold_ttf_len;
+    } else {
+      face.data = Roboto_v3_012_hinted_static_Roboto_Regular_ttf;
+      face.dataLen = Roboto_v3_012_hinted_static_Roboto_Regular_ttf_len;
+    }
+  }
+  return face;
+}
+
+int SnapToBucket(int size) {
+  for (int bucket : kSizeBuckets) {
+    if (bucket >= size)
+      return bucket;
+  }
+  return kSizeBuckets[std::size(kSizeBuckets) - 1];
+}
+
+void UploadPage(GlyphPage &page) {
+  Image image = {page.pixels.data(), kGlyphPageWidth, page.height, 1,
+                 PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA};
+  page.texture = LoadTextureFromImage(image);
+  SetTextureFilter(page.texture, TEXTURE_FILTER_BILINEAR);
+}
+
+// White with zero alpha, so bilinear filtering at glyph edges fades the
+// alpha without darkening the text color
+void ClearRows(GlyphPage &page, int fromRow) {
+  for (size_t i = (size_t)fromRow * kGlyphPageWidth * 2; i < page.pixels.size();
+       i += 2) {
+    page.pixels[i] = 255;
+    page.pixels[i + 1] = 0;
+  }
+}
+
+GlyphPage CreateGlyphPage() {
+  GlyphPage page;
+  page.height = kInitialPageHeight;
+  page.pixels.resize((size_t)kGlyphPageWidth * page.height * 2);
+  ClearRows(page, 0);
+  UploadPage(page);
+  return page;
+}
+
+bool GrowPage(FontFace &face, int pageIndex) {
+  GlyphPage &page = face.pages[pageIndex];
+  if (page.height >= kMaxPageHeight)
+    return false;
+
+  int oldRows = page.height;
+  unsigned int oldId = page.texture.id;
+  page.height = std::min(page.height * 2, kMaxPageHeight);
+  page.pixels.resize((size_t)kGlyphPageWidth * page.height * 2);
+  ClearRows(page, oldRows);
+
+  // Flush draws that still sample the old texture before dropping it
+  rlDrawRenderBatchActive();
+  UnloadTexture(page.texture);
+  UploadPage(page);
+
+  for (auto &[size, bucket] : face.buckets) {
+    if (bucket.font.texture.id == oldId)
+      bucket.font.texture = page.texture;
+  }
+  s_glyphGeneration++;
+  return true;
+}
+
+// Shelf-packs one glyph (plus padding) into a page
+bool PackGlyph(GlyphPage &page, int width, int height, Rectangle &rec) {
+  int w = width + 2 * kGlyphPadding;
+  int h = height + 2 * kGlyphPadding;
+  if (page.shelfX + w > kGlyphPageWidth) {
+    page.shelfX = 0;
+    page.shelfY += page.shelfHeight;
+    page.shelfHeight = 0;
+  }
+  if (w > kGlyphPageWidth || page.shelfY + h > page.height)
+    return false;
+  rec = {(float)(page.shelfX + kGlyphPadding),
+         (float)(page.shelfY + kGlyphPadding), (float)width, (float)height};
+  page.shelfX += w;
+  page.shelfHeight = std::max(page.shelfHeight, h);
+  return true;
+}
+
+// Packs a whole glyph set, growing the page as needed; on failure the shelf
+// state is restored so the page is untouched
+bool PackGlyphSet(FontFace &face, int pageIndex, const GlyphInfo *glyphs,
+                  int count, Rectangle *recs) {
+  GlyphPage saved = {};
+  saved.shelfX = face.pages[pageIndex].shelfX;
+  saved.shelfY = face.pages[pageIndex].shelfY;
+  saved.shelfHeight = face.pages[pageIndex].shelfHeight;
+
+  for (int i = 0; i < count; ++i) {
+    const Image &image = glyphs[i].image;
+    while (!PackGlyph(face.pages[pageIndex], image.width, image.height,
+                      recs[i])) {
+      if (!GrowPage(face, pageIndex)) {
+        GlyphPage &page = face.pages[pageIndex];
+        page.shelfX = saved.shelfX;
+        page.shelfY = saved.shelfY;
+        page.shelfHeight = saved.shelfHeight;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Copies glyph coverage into the page (CPU copy and texture) and frees the
+// glyph images, which are not needed once they live on the page
+void UploadGlyphs(GlyphPage &page, GlyphInfo *glyphs, int count,
+                  const Rectangle *recs) {
+  std::vector<unsigned char> pixels;
+  for (int i = 0; i < count; ++i) {
+    Image &image = glyphs[i].image;
+    int pixelCount = image.width * image.height;
+    if (pixelCount > 0 && image.data && recs[i].width > 0) {
+      // LoadFontData yields 8-bit coverage; pages are gray + alpha
+      const unsigned char *coverage = (const unsigned char *)image.data;
+      pixels.resize(pixelCount * 2);
+      for (int p = 0; p < pixelCount; ++p) {
+        pixels[p * 2] = 255;
+        pixels[p * 2 + 1] = coverage[p];
+      }
+      for (int row = 0; row < image.height; ++row) {
+        size_t dst = ((size_t)(recs[i].y + row) * kGlyphPageWidth +
+                      (size_t)recs[i].x) * 2;
+        std::copy_n(&pixels[(size_t)row * image.width * 2], image.width * 2,
+                    &page.pixels[dst]);
+      }
+      UpdateTextureRec(page.texture, recs[i], pixels.data());
+    }
+    UnloadImage(image);
+    image = {0};
+  }
+}
+
+// LoadFontData leaves codepoints the font has no glyph for empty: no image
+// and no advance
+bool IsMissingGlyph(const GlyphInfo &glyph) {
+  return glyph.image.data == nullptr && glyph.advanceX == 0;
+}
+
+// Replaces missing glyphs with the first fallback font that has them
+void ResolveFallbackGlyphs(GlyphInfo *glyphs, int count, int bucket) {
+  for (int i = 0; i < count; ++i) {
+    if (!IsMissingGlyph(glyphs[i]))
+      continue;
+    for (const FallbackFont &fallback : s_fallbackFonts) {
+      int codepoint = glyphs[i].value;
+      GlyphInfo *found = LoadFontData(fallback.data, fallback.dataLen, bucket,
+                                      &codepoint, 1, FONT_DEFAULT);
+      if (!found)
+        continue;
+      if (IsMissingGlyph(*found)) {
+        UnloadFontData(found, 1);
+        continue;
+      }
+      UnloadImage(glyphs[i].image);
+      glyphs[i] = *found;
+      MemFree(found); // The image now belongs to glyphs[i]
+      break;
+    }
+  }
+}
+
+constexpr int kBakedGlyphCount = 95; // ASCII 32..126
+
+// Rasterizes the baked glyph set at a bucket size. CPU only, so it can run
+// on worker threads.
+GlyphInfo *RasterizeBucket(const FontFace &face, int size) {
+  return LoadFontData(face.data, (int)face.dataLen, size, nullptr,
+                      kBakedGlyphCount, FONT_DEFAULT);
+}
+
+// Packs and uploads a rasterized bucket into a shared page (GL thread
+// only). Takes ownership of glyphs; returns false if the page budget is
+// exhausted.
+bool PlaceBucket(FontFace &face, int size, GlyphInfo *glyphs,
+                 GlyphBucket &bucket) {
+  const int glyphCount = kBakedGlyphCount;
+  if (!glyphs)
+    return false;
+
+  Rectangle *recs = (Rectangle *)MemAlloc(glyphCount * sizeof(Rectangle));
+  int page = (int)face.pages.size() - 1;
+  if (page < 0 || !PackGlyphSet(face, page, glyphs, glyphCount, recs)) {
+    page = -1;
+    if ((int)face.pages.size() < kMaxGlyphPagesPerFace) {
+      face.pages.push_back(CreateGlyphPage());
+      page = (int)face.pages.size() - 1;
+      if (!PackGlyphSet(face, page, glyphs, glyphCount, recs))
+        page = -1;
+    }
+  }
+
+  if (page < 0) {
+    UnloadFontData(glyphs, glyphCount);
+    MemFree(recs);
+    return false;
+  }
+
+  UploadGlyphs(face.pages[page], glyphs, glyphCount, recs);
+
+  bucket.font = {0};
+  bucket.font.baseSize = size;
+  bucket.font.glyphCount = glyphCount;
+  bucket.font.glyphPadding = kGlyphPadding;
+  bucket.font.texture = face.pages[page].texture;
+  bucket.font.recs = recs;
+  bucket.font.glyphs = glyphs;
+  bucket.page = page;
+  for (int i = 0; i < glyphCount; ++i) {
+    bucket.codepoints.insert(glyphs[i].value);
+  }
+  return true;
+}
+
+bool BuildBucket(FontFace &face, int size, GlyphBucket &bucket) {
+  return PlaceBucket(face, size, RasterizeBucket(face, size), bucket);
+}
+
+// Appends glyphs for new codepoints to a bucket's glyph table. Glyphs that
+// no longer fit on the bucket's page keep their advance but draw nothing.
+// Codepoints no font has are only recorded as unresolved. Returns false if
+// nothing was added.
+bool AppendGlyphs(FontFace &face, GlyphBucket &bucket,
+                  std::vector<int> &codepoints) {
+  int requested = (int)codepoints.size();
+  GlyphInfo *added = LoadFontData(face.data, (int)face.dataLen,
+                                   bucket.font.baseSize, codepoints.data(),
+                                   requested, FONT_DEFAULT);
+  if (!added)
+    return false;
+  ResolveFallbackGlyphs(added, requested, bucket.font.baseSize);
+
+  int count = 0;
+  for (int i = 0; i < requested; ++i) {
+    if (IsMissingGlyph(added[i])) {
+      bucket.unresolved.push_back(added[i].value);
+      UnloadImage(added[i].image);
+      continue;
+    }
+    added[count++] = added[i];
+  }
+  if (count == 0) {
+    MemFree(added);
+    return false;
+  }
+
+  Font &font = bucket.font;
+  int total = font.glyphCount + count;
+  font.glyphs =
+      (GlyphInfo *)MemRealloc(font.glyphs, total * sizeof(GlyphInfo));
+  font.recs = (Rectangle *)MemRealloc(font.recs, total * sizeof(Rectangle));
+
+  GlyphInfo *glyphs = font.glyphs + font.glyphCount;
+  Rectangle *recs = font.recs + font.glyphCount;
+  for (int i = 0; i < count; ++i) {
+    glyphs[i] = added[i];
+    const Image &image = glyphs[i].image;
+    recs[i] = {0, 0, 0, 0};
+    while (!PackGlyph(face.pages[bucket.page], image.width, image.height,
+                      recs[i])) {
+      if (!GrowPage(face, bucket.page))
+        break;
+    }
+  }
+  MemFree(added); // Images moved into font.glyphs
+
+  UploadGlyphs(face.pages[bucket.page], glyphs, count, recs);
+  font.glyphCount = total;
+  font.texture = face.pages[bucket.page].texture;
+  s_glyphGeneration++;
+  return true;
+}
+
+bool IsPageTexture(const FontFace &face, unsigned int textureId) {
+  for (const GlyphPage &page : face.pages) {
+    if (page.texture.id == textureId)
+      return true;
+  }
+  return false;
+}
+
+void UnloadFace(FontFace &face) {
+  for (auto &[size, bucket] : face.buckets) {
+    UnloadFontData(bucket.font.glyphs, bucket.font.glyphCount);
+    MemFree(bucket.font.recs);
+  }
+  face.buckets.clear();
+  for (GlyphPage &page : face.pages) {
+    UnloadTexture(page.texture);
+  }
+  face.pages.clear();
+}
+
+size_t PageBytes(const FontFace &face) {
+  size_t bytes = 0;
+  for (const GlyphPage &page : face.pages) {
+    bytes += (size_t)kGlyphPageWidth * page.height * 2;
+  }
+  return bytes;
+}
+
+} // namespace
+
 std::unordered_map<FontKey, Font, FontKeyHash> FontManager::fontCache_;
 Font FontManager::defaultFont_ = {0};
 bool FontManager::initialized_ = false;
@@ -18,14 +400,14 @@ void FontManager::Initialize() {
 }
 
 void FontManager::Shutdown() {
-  for (auto &[key, font] : fontCache_) {
-    if (font.texture.id != 0) {
-      UnloadFont(font);
-    }
-  }
+  // fontCache_ only holds copies of bucket fonts, which are owned by faces
   fontCache_.clear();
+  UnloadFace(s_regularFace);
+  UnloadFace(s_boldFace);
+  s_fallbackFonts.clear();
+  s_glyphGeneration++;
 
-  // defaultFont_ is a copy of a font in fontCache_, so it's already unloaded.
+  // defaultFont_ is a copy of a bucket font, so it's already unloaded.
   defaultFont_ = {0};
 
   initialized_ = false;
@@ -39,7 +421,12 @@ Font FontManager::LoadFont(FontWeight weight, FontStyle style, int size) {
     return it->second;
   }
 
+  uint32_t generation = s_glyphGeneration;
   Font font = LoadRobotoFont(weight, style, size);
+  if (generation != s_glyphGeneration) {
+    // A page grew while building the bucket; cached copies are stale
+    RefreshFontCopies();
+  }
   if (font.texture.id != 0) {
     fontCache_[key] = font;
   }
@@ -47,6 +434,150 @@ Font FontManager::LoadFont(FontWeight weight, FontStyle style, int size) {
   return font;
 }
 
+bool FontManager::RequestGlyphs(FontWeight weight, int size,
+                                const char *text) {
+  if (!text)
+    return false;
+
+  // The default set covers ASCII, so only non-ASCII text needs a look
+  const unsigned char *c = (const unsigned char *)text;
+  while (*c && *c < 0x80)
+    ++c;
+  if (!*c)
+    return false;
+
+  // Make sure the bucket exists (this may fall back to a resident one)
+  Font font = LoadFont(weight, FontStyle::Normal, size);
+  FontFace &face = GetFace(weight);
+  auto it = face.buckets.find(font.baseSize);
+  if (font.texture.id == 0 || it == face.buckets.end())
+    return false;
+  GlyphBucket &bucket = it->second;
+
+  std::vector<int> missing;
+  for (int i = (int)((const char *)c - text); text[i] != '\0';) {
+    int byteCount = 0;
+    int codepoint = GetCodepointNext(&text[i], &byteCount);
+    i += byteCount;
+    if (bucket.codepoints.insert(codepoint).second)
+      missing.push_back(codepoint);
+  }
+  if (missing.empty())
+    return false;
+
+  if (!AppendGlyphs(face, bucket, missing))
+    return false;
+  RefreshFontCopies();
+  return true;
+}
+
+bool FontManager::AddFallbackFont(const std::string &path) {
+  int dataSize = 0;
+  unsigned char *data = LoadFileData(path.c_str(), &dataSize);
+  if (!data)
+    return false;
+
+  FallbackFont fallback;
+  fallback.owned.assign(data, data + dataSize);
+  UnloadFileData(data);
+  fallback.data = fallback.owned.data();
+  fallback.dataLen = dataSize;
+  s_fallbackFonts.push_back(std::move(fallback));
+  ForgetMissingGlyphs();
+  return true;
+}
+
+void FontManager::AddFallbackFontFromMemory(const unsigned char *data,
+                                            int dataSize) {
+  if (!data || dataSize <= 0)
+    return;
+
+  FallbackFont fallback;
+  fallback.data = data;
+  fallback.dataLen = dataSize;
+  s_fallbackFonts.push_back(std::move(fallback));
+  ForgetMissingGlyphs();
+}
+
+void FontManager::PrewarmFonts(const std::vector<FontPrewarmRequest> &fonts,
+                               int workerCount) {
+  struct PrewarmJob {
+    FontFace *face;
+    int bucket;
+    GlyphInfo *glyphs;
+  };
+
+  std::vector<PrewarmJob> jobs;
+  for (const FontPrewarmRequest &request : fonts) {
+    FontFace *face = &GetFace(request.weight);
+    int bucket = SnapToBucket(request.size);
+    if (face->buckets.count(bucket))
+      continue;
+    bool queued = std::any_of(jobs.begin(), jobs.end(),
+                              [&](const PrewarmJob &job) {
+                                return job.face == face && job.bucket == bucket;
+                              });
+    if (!queued)
+      jobs.push_back({face, bucket, nullptr});
+  }
+  if (jobs.empty())
+    return;
+
+  // Rasterize in parallel; the calling thread works too
+  if (workerCount <= 0)
+    workerCount = (int)std::max(1u, std::thread::hardware_concurrency());
+  workerCount = std::min(workerCount, (int)jobs.size());
+
+  std::atomic<size_t> next{0};
+  auto rasterize = [&]() {
+    for (size_t i = next++; i < jobs.size(); i = next++) {
+      jobs[i].glyphs = RasterizeBucket(*jobs[i].face, jobs[i].bucket);
+    }
+  };
+  std::vector<std::thread> workers;
+  for (int i = 1; i < workerCount; ++i) {
+    workers.emplace_back(rasterize);
+  }
+  rasterize();
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+
+  // Pack and upload on this thread, which owns the GL context
+  uint32_t generation = s_glyphGeneration;
+  for (PrewarmJob &job : jobs) {
+    GlyphBucket bucket;
+    if (PlaceBucket(*job.face, job.bucket, job.glyphs, bucket)) {
+      job.face->buckets[job.bucket] = std::move(bucket);
+    }
+  }
+  if (generation != s_glyphGeneration) {
+    RefreshFontCopies();
+  }
+}
+
+uint32_t FontManager::GetGlyphGeneration() { return s_glyphGeneration; }
+
+void FontManager::RefreshFontCopies() {
+  fontCache_.clear();
+  if (defaultFont_.texture.id != 0) {
+    defaultFont_ = LoadFont(FontWeight::Regular, FontStyle::Normal, 16);
+  }
+}
+
+void FontManager::ForgetMissingGlyphs() {
+  // Codepoints no font had never entered a glyph table; let the next draw
+  // retry them against the new fallback
+  for (FontFace *face : {&s_regularFace, &s_boldFace}) {
+    for (auto &[size, bucket] : face->buckets) {
+      for (int codepoint : bucket.unresolved) {
+        bucket.codepoints.erase(codepoint);
+      }
+      bucket.unresolved.clear();
+    }
+  }
+}
+
 Font FontManager::LoadCustomFont(const std::string &path, int size) {
   std::string resolvedPath = path;
   
@@ -78,27 +609,52 @@ Font FontManager::LoadCustomFont(const std::string &path, int size) {
 }
 
 void FontManager::UnloadFont(Font font) {
+  // Fonts from LoadFont live on shared pages and are freed by Shutdown
+  if (IsPageTexture(s_regularFace, font.texture.id) ||
+      IsPageTexture(s_boldFace, font.texture.id))
+    return;
   if (font.texture.id != 0) {
     ::UnloadFont(font);
   }
 }
 
 Font FontManager::LoadRobotoFont(FontWeight weight, FontStyle style, int size) {
-  // Map weights to available embedded fonts
-  unsigned char *fontData = nullptr;
-  unsigned int fontDataLen = 0;
+  FontFace &face = GetFace(weight);
+  int bucket = SnapToBucket(size);
 
-  if (weight == FontWeight::Bold || weight == FontWeight::Black) {
-    fontData = Roboto_v3_012_hinted_static_Roboto_Bold_ttf;
-    fontDataLen = Roboto_v3_012_hinted_static_Roboto_Bold_ttf_len;
-  } else {
-    fontData = Roboto_v3_012_hinted_static_Roboto_Regular_ttf;
-    fontDataLen = Roboto_v3_012_hinted_static_Roboto_Regular_ttf_len;
+  auto it = face.buckets.find(bucket);
+  if (it != face.buckets.end())
+    return it->second.font;
+
+  GlyphBucket built;
+  if (BuildBucket(face, bucket, built)) {
+    return (face.buckets[bucket] = std::move(built)).font;
   }
 
-  Font font =
-      LoadFontFromMemory(".ttf", fontData, fontDataLen, size, nullptr, 0);
-  return font;
+  // Page budget exhausted: scale the closest bucket that is already resident
+  Font closest = {0};
+  int closestDistance = 0;
+  for (auto &[residentSize, resident] : face.buckets) {
+    int distance = std::abs(residentSize - bucket);
+    if (closest.texture.id == 0 || distance < closestDistance) {
+      closest = resident.font;
+      closestDistance = distance;
+    }
+  }
+  return closest;
+}
+
+FontCacheStats FontManager::GetCacheStats() {
+  FontCacheStats stats;
+  for (const FontFace *face : {&s_regularFace, &s_boldFace}) {
+    stats.pages += (int)face->pages.size();
+    stats.sizes += (int)face->buckets.size();
+    stats.residentBytes += PageBytes(*face);
+    for (const auto &[size, bucket] : face->buckets) {
+      stats.glyphs += bucket.font.glyphCount;
+    }
+  }
+  return stats;
 }
 
 } // namespace raym3
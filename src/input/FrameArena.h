@@ -0,0 +1,63 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace raym3 {
+
+// Bump allocator for data that lives for one frame. Reset keeps the blocks,
+// so once the largest frame has been seen recording allocates nothing.
+// Destructors are not run; owners of non-trivial objects destroy them.
+class FrameArena {
+public:
+  explicit FrameArena(size_t blockSize = 64 * 1024) : blockSize_(blockSize) {}
+
+  void *Allocate(size_t size, size_t align) {
+    while (block_ < blocks_.size()) {
+      Block &block = blocks_[block_];
+      size_t offset = (offset_ + align - 1) & ~(align - 1);
+      if (offset + size <= block.size) {
+        offset_ = offset + size;
+        return block.data.get() + offset;
+      }
+      block_++;
+      offset_ = 0;
+    }
+    // Oversized requests get a block of their own
+    size_t capacity = std::max(blockSize_, size + align);
+    blocks_.push_back({std::make_unique<unsigned char[]>(capacity), capacity});
+    block_ = blocks_.size() - 1;
+    offset_ = 0;
+    return Allocate(size, align);
+  }
+
+  const char *CopyString(const char *text) {
+    size_t length = text ? std::strlen(text) : 0;
+    char *copy = static_cast<char *>(Allocate(length + 1, 1));
+    std::copy(text, text + length, copy);
+    copy[length] = '\0';
+    return copy;
+  }
+
+  void Reset() {
+    block_ = 0;
+    offset_ = 0;
+  }
+
+private:
+  struct Block {
+    std::unique_ptr<unsigned char[]> data;
+    size_t size;
+  };
+
+  std::vector<Block> blocks_;
+  size_t blockSize_;
+  size_t block_ = 0;
+  size_t offset_ = 0;
+};
+
+} // namespace raym3
@@ -3,19 +3,121 @@
 #if RAYM3_USE_INPUT_LAYERS
 
 #include <algorithm>
+#include <bit>
+#include <cmath>
 
 namespace raym3 {
 
+namespace {
+
+constexpr int kNoLayer = -1; // Layer ids are >= 0
+constexpr int kMaxGridCells = 64; // Per axis
+constexpr float kMinCellSize = 32.0f;
+
+// Uniform grid over the blocking regions of the frame, for queries at
+// points other than the mouse. Built on first use; each cell lists the
+// regions overlapping it (CSR layout).
+struct BlockingGrid {
+  bool built = false;
+  float originX = 0.0f;
+  float originY = 0.0f;
+  float cellSize = kMinCellSize;
+  int columns = 0;
+  int rows = 0;
+  std::vector<uint32_t> cellStart; // columns * rows + 1 offsets
+  std::vector<uint32_t> cellItems; // Region indices
+
+  void Build(const std::vector<BlockingRegion> &regions) {
+    built = true;
+    columns = rows = 0;
+    cellStart.clear();
+    cellItems.clear();
+
+    float minX = INFINITY, minY = INFINITY, maxX = -INFINITY, maxY = -INFINITY;
+    for (const BlockingRegion &region : regions) {
+      if (!region.blocksInput)
+        continue;
+      minX = std::min(minX, region.bounds.x);
+      minY = std::min(minY, region.bounds.y);
+      maxX = std::max(maxX, region.bounds.x + region.bounds.width);
+      maxY = std::max(maxY, region.bounds.y + region.bounds.height);
+    }
+    if (minX > maxX || minY > maxY)
+      return;
+
+    originX = minX;
+    originY = minY;
+    cellSize = std::max({kMinCellSize, (maxX - minX) / kMaxGridCells,
+                         (maxY - minY) / kMaxGridCells});
+    columns = std::min(kMaxGridCells, (int)((maxX - minX) / cellSize) + 1);
+    rows = std::min(kMaxGridCells, (int)((maxY - minY) / cellSize) + 1);
+
+    // Count, prefix-sum, then fill
+    std::vector<uint32_t> counts(columns * rows + 1, 0);
+    auto forCells = [&](const Rectangle &bounds, auto &&fn) {
+      int x0 = CellX(bounds.x);
+      int x1 = CellX(bounds.x + bounds.width);
+      int y0 = CellY(bounds.y);
+      int y1 = CellY(bounds.y + bounds.height);
+      for (int y = y0; y <= y1; ++y)
+        for (int x = x0; x <= x1; ++x)
+          fn(y * columns + x);
+    };
+    for (const BlockingRegion &region : regions) {
+      if (region.blocksInput)
+        forCells(region.bounds, [&](int cell) { counts[cell + 1]++; });
+    }
+    for (size_t i = 1; i < counts.size(); ++i)
+      counts[i] += counts[i - 1];
+    cellStart = counts;
+    cellItems.resize(counts.back());
+    for (uint32_t i = 0; i < regions.size(); ++i) {
+      if (!regions[i].blocksInput)
+        continue;
+      forCells(regions[i].bounds,
+               [&](int cell) { cellItems[counts[cell]++] = i; });
+    }
+  }
+
+  int CellX(float x) const {
+    return std::clamp((int)std::floor((x - originX) / cellSize), 0,
+                      columns - 1);
+  }
+  int CellY(float y) const {
+    return std::clamp((int)std::floor((y - originY) / cellSize), 0, rows - 1);
+  }
+
+  template <typename Test> int TopLayerAt(Vector2 point, Test &&test) const {
+    if (columns == 0)
+      return kNoLayer;
+    float localX = point.x - originX;
+    float localY = point.y - originY;
+    if (localX < 0.0f || localY < 0.0f || localX > columns * cellSize ||
+        localY > rows * cellSize)
+      return kNoLayer;
+    int cell = CellY(point.y) * columns + CellX(point.x);
+    int top = kNoLayer;
+    for (uint32_t i = cellStart[cell]; i < cellStart[cell + 1]; ++i) {
+      top = std::max(top, test(cellItems[i]));
+    }
+    return top;
+  }
+};
+
+BlockingGrid s_blockingGrid;
+
+} // namespace
+
 std::vector<BlockingRegion> InputLayerManager::blockingRegions_;
 std::vector<BlockingRegion> InputLayerManager::activeBlockingRegions_;
 int InputLayerManager::currentLayerId_ = 0;
 std::vector<int> InputLayerManager::layerStack_ = {0};
 int InputLayerManager::registrationOrder_ = 0;
-InputCapture InputLayerManager::currentCapture_ = {
-    .captureBounds = {0, 0, 0, 0},
-    .captureLayerId = -1,
-    .isActive = false,
-    .captureStartPos = {0, 0}};
+InputCapture InputLayerManager::pointerCaptures_[kMaxPointers] = {};
+PointerState InputLayerManager::pointers_[kMaxPointers];
+uint32_t InputLayerManager::activePointers_ = 0;
+InputQueryStats InputLayerManager::frameStats_;
+InputQueryStats InputLayerManager::lastFrameStats_;
 
 void InputLayerManager::Initialize() {
   blockingRegions_.clear();
@@ -23,7 +125,15 @@ void InputLayerManager::Initialize() {
   currentLayerId_ = 0;
   layerStack_ = {0};
   registrationOrder_ = 0;
-  currentCapture_.isActive = false;
+  for (int i = 0; i < kMaxPointers; ++i) {
+    pointerCaptures_[i] = {};
+    pointerCaptures_[i].captureLayerId = -1;
+    pointers_[i] = {};
+  }
+  activePointers_ = 0;
+  s_blockingGrid = BlockingGrid();
+  frameStats_ = {};
+  lastFrameStats_ = {};
 }
 
 void InputLayerManager::BeginFrame() {
@@ -34,12 +144,21 @@ void InputLayerManager::BeginFrame() {
   blockingRegions_.clear();
   registrationOrder_ = 0;
 
+  lastFrameStats_ = frameStats_;
+  frameStats_ = {};
+  frameStats_.regions = activeBlockingRegions_.size();
+
+  // Pointers do not move within a frame, so resolving each one here answers
+  // every widget's query; other points go through the grid
+  s_blockingGrid.built = false;
+  ResolvePointers();
+
   // Reset layer stack to base layer
   layerStack_ = {0};
   currentLayerId_ = 0;
 
   // Check if capture should be released (mouse button up)
-  if (currentCapture_.isActive) {
+  if (pointerCaptures_[0].isActive) {
     // Fix: Use !IsMouseButtonDown instead of IsMouseButtonReleased to prevent
     // stuck capture if the release frame was missed (e.g. lag, focus loss)
     bool leftUp = !IsMouseButtonDown(MOUSE_BUTTON_LEFT);
@@ -47,7 +166,136 @@ void InputLayerManager::BeginFrame() {
     bool middleUp = !IsMouseButtonDown(MOUSE_BUTTON_MIDDLE);
 
     if (leftUp && rightUp && middleUp) {
-      currentCapture_.isActive = false;
+      pointerCaptures_[0].isActive = false;
+    }
+  }
+}
+
+void InputLayerManager::ResolvePointers() {
+  // The mouse pointer is the primary button, like a touch
+  PointerState &mouse = pointers_[0];
+  mouse = {};
+  mouse.active = true;
+  mouse.position = GetMousePosition();
+  mouse.down = IsMouseButtonDown(MOUSE_BUTTON_LEFT);
+  mouse.pressed = IsMouseButtonPressed(MOUSE_BUTTON_LEFT);
+  mouse.released = IsMouseButtonReleased(MOUSE_BUTTON_LEFT);
+
+  // Touches keep the slot of their id from last frame; new ids take free
+  // slots, preferring ones that were not down last frame so a lifted finger
+  // still reports its release. A slot whose finger lifted drops its capture.
+  int touchCount = std::min(GetTouchPointCount(), kMaxPointers - 1);
+  int touchIds[kMaxPointers - 1];
+  Vector2 touchPositions[kMaxPointers - 1];
+  bool assigned[kMaxPointers - 1] = {};
+  for (int i = 0; i < touchCount; ++i) {
+    touchIds[i] = GetTouchPointId(i);
+    touchPositions[i] = GetTouchPosition(i);
+  }
+
+  bool kept[kMaxPointers] = {};
+  for (int slot = 1; slot < kMaxPointers; ++slot) {
+    PointerState &pointer = pointers_[slot];
+    if (!pointer.active)
+      continue;
+    for (int i = 0; i < touchCount; ++i) {
+      if (!assigned[i] && touchIds[i] == pointer.touchId) {
+        pointer.position = touchPositions[i];
+        pointer.pressed = false;
+        assigned[i] = true;
+        kept[slot] = true;
+        break;
+      }
+    }
+  }
+  for (int i = 0; i < touchCount; ++i) {
+    if (assigned[i])
+      continue;
+    int freeSlot = -1;
+    for (int slot = 1; slot < kMaxPointers; ++slot) {
+      if (kept[slot])
+        continue;
+      if (!pointers_[slot].active) {
+        freeSlot = slot;
+        break;
+      }
+      if (freeSlot < 0)
+        freeSlot = slot;
+    }
+    if (freeSlot < 0)
+      break;
+    pointers_[freeSlot] = {};
+    pointers_[freeSlot].touchId = touchIds[i];
+    pointers_[freeSlot].position = touchPositions[i];
+    pointers_[freeSlot].pressed = true;
+    pointerCaptures_[freeSlot].isActive = false; // Held by a lifted finger
+    kept[freeSlot] = true;
+  }
+
+  activePointers_ = 1u;
+  for (int slot = 1; slot < kMaxPointers; ++slot) {
+    PointerState &pointer = pointers_[slot];
+    if (!kept[slot]) {
+      // A finger that lifted this frame stays readable as released
+      bool lifted = pointer.active;
+      PointerState last = pointer;
+      pointer = {};
+      if (lifted) {
+        pointer.touchId = last.touchId;
+        pointer.position = last.position;
+        pointer.released = true;
+      }
+      pointerCaptures_[slot].isActive = false;
+      continue;
+    }
+    pointer.active = true;
+    pointer.down = true;
+    activePointers_ |= 1u << slot;
+    // raylib mirrors the first touch as the mouse; count that finger once
+    if (mouse.active && mouse.down && pointer.position.x == mouse.position.x &&
+        pointer.position.y == mouse.position.y) {
+      mouse.active = false;
+      activePointers_ &= ~1u;
+    }
+  }
+
+  // The mouse keeps answering the single-pointer API even when mirrored
+  ResolveTarget(mouse);
+  for (int slot = 1; slot < kMaxPointers; ++slot) {
+    if ((activePointers_ & (1u << slot)) || pointers_[slot].released)
+      ResolveTarget(pointers_[slot]);
+  }
+}
+
+void InputLayerManager::ResolveTarget(PointerState &pointer) {
+  pointer.topLayer = kNoLayer;
+  pointer.targetRegion = -1;
+  // A lone mouse is cheaper to test linearly than to build the grid for
+  bool useGrid = (activePointers_ & ~1u) != 0;
+  if (useGrid && !s_blockingGrid.built)
+    s_blockingGrid.Build(activeBlockingRegions_);
+
+  auto test = [&](const BlockingRegion &region) {
+    frameStats_.regionTests++;
+    if (!CheckCollisionPointRec(pointer.position, region.bounds))
+      return kNoLayer;
+    // Ties go to the later registration, which is drawn on top
+    if (region.layerId > pointer.topLayer ||
+        (region.layerId == pointer.topLayer &&
+         region.registrationOrder > pointer.targetRegion)) {
+      pointer.topLayer = region.layerId;
+      pointer.targetRegion = region.registrationOrder;
+    }
+    return region.layerId;
+  };
+  if (useGrid) {
+    s_blockingGrid.TopLayerAt(pointer.position, [&](uint32_t index) {
+      return test(activeBlockingRegions_[index]);
+    });
+  } else {
+    for (const auto &region : activeBlockingRegions_) {
+      if (region.blocksInput)
+        test(region);
     }
   }
 }
@@ -151,13 +399,13 @@ bool InputLayerManager::BeginInputCapture(Rectangle bounds,
   int componentLayerId = (layerId >= 0) ? layerId : currentLayerId_;
 
   // If already captured by someone else, deny
-  if (currentCapture_.isActive &&
+  if (pointerCaptures_[0].isActive &&
       !IsInputCapturedBy(bounds, componentLayerId)) {
     return false;
   }
 
   // If not captured yet, check if we should capture on this frame
-  if (!currentCapture_.isActive) {
+  if (!pointerCaptures_[0].isActive) {
     bool anyMouseDown = IsMouseButtonDown(MOUSE_BUTTON_LEFT) ||
                         IsMouseButtonDown(MOUSE_BUTTON_RIGHT) ||
                         IsMouseButtonDown(MOUSE_BUTTON_MIDDLE);
@@ -185,10 +433,10 @@ bool InputLayerManager::BeginInputCapture(Rectangle bounds,
           // Note: componentLayerId might differ from currentLayerId_ if View3D
           // has already popped its layer This is fine - we store the layer ID
           // that the component is on
-          currentCapture_.captureBounds = bounds;
-          currentCapture_.captureLayerId = componentLayerId;
-          currentCapture_.isActive = true;
-          currentCapture_.captureStartPos = mousePos;
+          pointerCaptures_[0].captureBounds = bounds;
+          pointerCaptures_[0].captureLayerId = componentLayerId;
+          pointerCaptures_[0].isActive = true;
+          pointerCaptures_[0].captureStartPos = mousePos;
           return true;
         }
 
@@ -201,10 +449,10 @@ bool InputLayerManager::BeginInputCapture(Rectangle bounds,
         currentLayerId_ = savedLayerId;
 
         if (canProcess) {
-          currentCapture_.captureBounds = bounds;
-          currentCapture_.captureLayerId = componentLayerId;
-          currentCapture_.isActive = true;
-          currentCapture_.captureStartPos = mousePos;
+          pointerCaptures_[0].captureBounds = bounds;
+          pointerCaptures_[0].captureLayerId = componentLayerId;
+          pointerCaptures_[0].isActive = true;
+          pointerCaptures_[0].captureStartPos = mousePos;
           return true;
         }
         return false;
@@ -220,7 +468,7 @@ bool InputLayerManager::BeginInputCapture(Rectangle bounds,
   }
 
   // Already captured by us, verify it's still valid
-  if (currentCapture_.captureLayerId == componentLayerId) {
+  if (pointerCaptures_[0].captureLayerId == componentLayerId) {
     return true;
   }
 
@@ -228,23 +476,32 @@ bool InputLayerManager::BeginInputCapture(Rectangle bounds,
   return false;
 }
 
-bool InputLayerManager::IsInputCaptured() { return currentCapture_.isActive; }
+bool InputLayerManager::IsInputCaptured() {
+  return pointerCaptures_[0].isActive;
+}
 
 bool InputLayerManager::IsInputCapturedBy(Rectangle bounds, int layerId) {
-  if (!currentCapture_.isActive)
+  if (!pointerCaptures_[0].isActive)
     return false;
 
   // Use provided layerId or fall back to current layer
   int componentLayerId = (layerId >= 0) ? layerId : currentLayerId_;
 
-  return currentCapture_.captureBounds.x == bounds.x &&
-         currentCapture_.captureBounds.y == bounds.y &&
-         currentCapture_.captureBounds.width == bounds.width &&
-         currentCapture_.captureBounds.height == bounds.height &&
-         currentCapture_.captureLayerId == componentLayerId;
+  return SameCapture(pointerCaptures_[0], bounds, componentLayerId);
 }
 
-void InputLayerManager::ReleaseCapture() { currentCapture_.isActive = false; }
+bool InputLayerManager::SameCapture(const InputCapture &capture,
+                                    Rectangle bounds, int layerId) {
+  return capture.captureBounds.x == bounds.x &&
+         capture.captureBounds.y == bounds.y &&
+         capture.captureBounds.width == bounds.width &&
+         capture.captureBounds.height == bounds.height &&
+         capture.captureLayerId == layerId;
+}
+
+void InputLayerManager::ReleaseCapture() {
+  pointerCaptures_[0].isActive = false;
+}
 
 bool InputLayerManager::ShouldProcessMouseInput(Rectangle bounds, int layerId) {
   Vector2 mousePos = GetMousePosition();
@@ -255,36 +512,33 @@ bool InputLayerManager::ShouldProcessMouseInput(Rectangle bounds, int layerId) {
 
   int askingLayerId = (layerId >= 0) ? layerId : currentLayerId_;
 
-  // Check active blocking regions (from last frame)
-  for (const auto &region : activeBlockingRegions_) {
-    if (!region.blocksInput)
-      continue;
-    if (!CheckCollisionPointRec(mousePos, region.bounds))
-      continue;
-
-    if (region.layerId > askingLayerId) {
-      return false;
-    }
-  }
-
-  return true;
+  // Blocked by an active region (from last frame) on a higher layer
+  frameStats_.queries++;
+  return TopBlockingLayerAt(mousePos) <= askingLayerId;
 }
 
 bool InputLayerManager::IsBlockedByHigherLayer(int layerId, Vector2 mousePos) {
-  // Check all active blocking regions
-  for (const auto &region : activeBlockingRegions_) {
-    if (!region.blocksInput)
-      continue;
-    if (!CheckCollisionPointRec(mousePos, region.bounds))
-      continue;
+  frameStats_.queries++;
+  return TopBlockingLayerAt(mousePos) > layerId;
+}
 
-    // Is this blocking region above the specified layer?
-    if (region.layerId > layerId) {
-      return true;
-    }
+int InputLayerManager::TopBlockingLayerAt(Vector2 point) {
+  // Resolved pointers (the mouse is always resolved) answer without tests
+  for (int slot = 0; slot < kMaxPointers; ++slot) {
+    const PointerState &pointer = pointers_[slot];
+    if ((slot == 0 || pointer.active) && point.x == pointer.position.x &&
+        point.y == pointer.position.y)
+      return pointer.topLayer;
   }
 
-  return false;
+  if (!s_blockingGrid.built)
+    s_blockingGrid.Build(activeBlockingRegions_);
+  return s_blockingGrid.TopLayerAt(point, [&](uint32_t index) {
+    const BlockingRegion &region = activeBlockingRegions_[index];
+    frameStats_.regionTests++;
+    return CheckCollisionPointRec(point, region.bounds) ? region.layerId
+                                                        : kNoLayer;
+  });
 }
 
 void InputLayerManager::ConsumeInput() {
@@ -293,6 +547,95 @@ void InputLayerManager::ConsumeInput() {
   // blocking
 }
 
+PointerState InputLayerManager::GetPointer(int pointer) {
+  if (pointer < 0 || pointer >= kMaxPointers)
+    return {};
+  return pointers_[pointer];
+}
+
+uint32_t InputLayerManager::GetActivePointers() { return activePointers_; }
+
+uint32_t InputLayerManager::GetPointersOver(Rectangle bounds, int layerId) {
+  int askingLayerId = (layerId >= 0) ? layerId : currentLayerId_;
+  frameStats_.queries++;
+  uint32_t result = 0;
+  for (uint32_t mask = activePointers_; mask; mask &= mask - 1) {
+    int slot = std::countr_zero(mask);
+    const PointerState &pointer = pointers_[slot];
+    if (pointer.topLayer <= askingLayerId &&
+        CheckCollisionPointRec(pointer.position, bounds))
+      result |= 1u << slot;
+  }
+  return result;
+}
+
+uint32_t InputLayerManager::GetPointersReleasedOver(Rectangle bounds,
+                                                    int layerId) {
+  int askingLayerId = (layerId >= 0) ? layerId : currentLayerId_;
+  frameStats_.queries++;
+  uint32_t result = 0;
+  for (int slot = 0; slot < kMaxPointers; ++slot) {
+    const PointerState &pointer = pointers_[slot];
+    if (pointer.released && pointer.topLayer <= askingLayerId &&
+        CheckCollisionPointRec(pointer.position, bounds))
+      result |= 1u << slot;
+  }
+  return result;
+}
+
+bool InputLayerManager::BeginPointerCapture(int pointer, Rectangle bounds,
+                                            int layerId) {
+  if (pointer < 0 || pointer >= kMaxPointers)
+    return false;
+
+  int componentLayerId = (layerId >= 0) ? layerId : currentLayerId_;
+  InputCapture &capture = pointerCaptures_[pointer];
+  if (capture.isActive && SameCapture(capture, bounds, componentLayerId))
+    return true;
+
+  // Only a press starts a capture. A capture taken earlier in the press
+  // frame (e.g. by an enclosing scroll container through BeginInputCapture)
+  // goes to the widget declared after it, which is the one on top.
+  const PointerState &state = pointers_[pointer];
+  if (!state.pressed ||
+      !(GetPointersOver(bounds, componentLayerId) & (1u << pointer)))
+    return false;
+
+  capture.captureBounds = bounds;
+  capture.captureLayerId = componentLayerId;
+  capture.isActive = true;
+  capture.captureStartPos = state.position;
+  return true;
+}
+
+bool InputLayerManager::IsPointerCapturedBy(int pointer, Rectangle bounds,
+                                            int layerId) {
+  if (pointer < 0 || pointer >= kMaxPointers)
+    return false;
+  int componentLayerId = (layerId >= 0) ? layerId : currentLayerId_;
+  const InputCapture &capture = pointerCaptures_[pointer];
+  return capture.isActive && SameCapture(capture, bounds, componentLayerId);
+}
+
+uint32_t InputLayerManager::GetPointersCapturedBy(Rectangle bounds,
+                                                  int layerId) {
+  int componentLayerId = (layerId >= 0) ? layerId : currentLayerId_;
+  uint32_t result = 0;
+  for (int slot = 0; slot < kMaxPointers; ++slot) {
+    const InputCapture &capture = pointerCaptures_[slot];
+    if (capture.isActive && SameCapture(capture, bounds, componentLayerId))
+      result |= 1u << slot;
+  }
+  return result;
+}
+
+void InputLayerManager::ReleasePointerCapture(int pointer) {
+  if (pointer >= 0 && pointer < kMaxPointers)
+    pointerCaptures_[pointer].isActive = false;
+}
+
+InputQueryStats InputLayerManager::GetQueryStats() { return lastFrameStats_; }
+
 } // namespace raym3
 
 #endif // RAYM3_USE_INPUT_LAYERS
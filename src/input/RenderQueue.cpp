@@ -2,12 +2,24 @@
 
 #if RAYM3_USE_INPUT_LAYERS
 
+#include "input/FrameArena.h"
+#include "input/RenderSort.h"
 #include "raym3/layout/Layout.h"
+#include "raym3/rendering/Renderer.h"
+#include "raym3/rendering/SvgRenderer.h"
 #include <algorithm>
 
 namespace raym3 {
 
+namespace {
+
+FrameArena s_frameArena;
+std::vector<uint64_t> s_sortScratch;
+
+} // namespace
+
 std::vector<RenderCommand> RenderQueue::renderQueue_;
+std::vector<uint64_t> RenderQueue::sortKeys_;
 int RenderQueue::currentLayerId_ = 0;
 std::vector<int> RenderQueue::layerStack_ = {0};
 int RenderQueue::registrationCounter_ = 0;
@@ -27,8 +39,15 @@ void RenderQueue::BeginFrame() {
 }
 
 void RenderQueue::Clear() {
+  for (const RenderCommand &cmd : renderQueue_) {
+    if (cmd.kind == RenderCommandKind::Callback && cmd.callback.destroy) {
+      cmd.callback.destroy(cmd.callback.callable);
+    }
+  }
   renderQueue_.clear();
   inputBlockingLayers_.clear();
+  s_frameArena.Reset();
+  registrationCounter_ = 0; // Registration order indexes renderQueue_
 }
 
 void RenderQueue::PushLayer(int zOrder) {
@@ -55,31 +74,73 @@ int RenderQueue::GetCurrentLayerId() {
   return layerStack_.back();
 }
 
-Rectangle RenderQueue::RegisterComponent(
-    ComponentType type,
-    std::function<void(Rectangle)> renderFunc,
-    int layerId,
-    bool consumesInput) {
-  
+void *RenderQueue::AllocateFrame(size_t size, size_t align) {
+  return s_frameArena.Allocate(size, align);
+}
+
+RenderCommand &RenderQueue::Record(ComponentType type, RenderCommandKind kind,
+                                   int layerId, bool consumesInput) {
   // Allocate space in the layout system
-  // This returns bounds from the PREVIOUS frame
+  // This returns bounds from the PREVIOUS frame; in same-frame mode they are
+  // replaced by this frame's bounds before the queue is executed
   Rectangle bounds = Layout::Alloc(Layout::Flex(0));
-  
-  // Capture everything needed for rendering
-  RenderCommand cmd;
+
+  RenderCommand &cmd = renderQueue_.emplace_back();
   cmd.type = type;
+  cmd.kind = kind;
   cmd.bounds = bounds;
+  cmd.layoutId = Layout::GetLastId();
+  cmd.clipId = Layout::GetScrollContainerId();
   cmd.layerId = (layerId == 0) ? currentLayerId_ : layerId;
   cmd.zOrder = cmd.layerId;
   cmd.consumesInput = consumesInput;
   cmd.registrationOrder = registrationCounter_++;
-  cmd.renderFunc = [renderFunc, bounds]() {
-    renderFunc(bounds);
-  };
-  
-  renderQueue_.push_back(cmd);
-  
-  return bounds;
+  cmd.color = {0, 0, 0, 0};
+  return cmd;
+}
+
+Rectangle RenderQueue::RegisterRoundedRect(ComponentType type, Color color,
+                                           float cornerRadius, float lineWidth,
+                                           int layerId, bool consumesInput) {
+  RenderCommand &cmd =
+      Record(type, RenderCommandKind::RoundedRect, layerId, consumesInput);
+  cmd.color = color;
+  cmd.rect.cornerRadius = cornerRadius;
+  cmd.rect.lineWidth = lineWidth;
+  return cmd.bounds;
+}
+
+Rectangle RenderQueue::RegisterText(const char *text, float fontSize,
+                                    Color color, FontWeight weight,
+                                    int layerId) {
+  const char *copy = s_frameArena.CopyString(text);
+  RenderCommand &cmd =
+      Record(ComponentType::Text, RenderCommandKind::Text, layerId, false);
+  cmd.color = color;
+  cmd.text.text = copy;
+  cmd.text.fontSize = fontSize;
+  cmd.text.weight = weight;
+  return cmd.bounds;
+}
+
+Rectangle RenderQueue::RegisterIcon(const char *name, Color color,
+                                    IconVariation variation, int layerId) {
+  const char *copy = s_frameArena.CopyString(name);
+  RenderCommand &cmd =
+      Record(ComponentType::Icon, RenderCommandKind::Icon, layerId, false);
+  cmd.color = color;
+  cmd.icon.name = copy;
+  cmd.icon.variation = variation;
+  return cmd.bounds;
+}
+
+void RenderQueue::ResolveBounds() {
+  // Layout::End has run by now, so the stored bounds are this frame's
+  for (auto& cmd : renderQueue_) {
+    if (cmd.layoutId != 0) {
+      cmd.bounds = Layout::GetBounds(cmd.layoutId);
+    }
+  }
 }
 
 void RenderQueue::BuildInputBlockingMap() {
@@ -136,24 +197,73 @@ bool RenderQueue::ShouldReceiveInput(Rectangle bounds, int layerId) {
 }
 
 void RenderQueue::ExecuteRenderQueue() {
-  // Build input blocking map first
+  bool sameFrame = Layout::IsSameFrameResolve();
+  if (sameFrame) {
+    ResolveBounds();
+  }
+
+  // Build input blocking map first (after bounds are final)
   BuildInputBlockingMap();
   
-  // Sort by Z-order (back to front)
-  // Lower zOrder = rendered first (in back)
-  // Higher zOrder = rendered last (in front)
-  std::stable_sort(renderQueue_.begin(), renderQueue_.end(),
-    [](const RenderCommand& a, const RenderCommand& b) {
-      if (a.zOrder != b.zOrder) {
-        return a.zOrder < b.zOrder;
+  // Sort by Z-order (back to front), same layer in registration order.
+  // Only the packed keys move; keys are built in registration order, so a
+  // stable radix sort on the layer half gives the full order.
+  sortKeys_.clear();
+  for (const RenderCommand &cmd : renderQueue_) {
+    sortKeys_.push_back(MakeRenderSortKey(cmd.zOrder, cmd.registrationOrder));
+  }
+  RadixSortKeys(sortKeys_, s_sortScratch);
+
+  // Execute render commands in order. The scroll container's scissor ended
+  // during the build pass; re-apply it with the container's resolved bounds,
+  // switching only when consecutive commands change container so a run of
+  // clipped commands shares one scissor (and one draw batch).
+  LayoutId activeClip = 0;
+  Renderer::BeginShapeBatch();
+  for (uint64_t key : sortKeys_) {
+    const RenderCommand &cmd = renderQueue_[static_cast<uint32_t>(key)];
+    LayoutId clipId = sameFrame ? cmd.clipId : 0;
+    if (clipId != activeClip) {
+      if (clipId != 0) {
+        // BeginScissorMode flushes and replaces any active scissor
+        Rectangle clipBounds = Layout::GetBounds(clipId);
+        BeginScissorMode((int)clipBounds.x, (int)clipBounds.y,
+                         (int)clipBounds.width, (int)clipBounds.height);
+      } else {
+        EndScissorMode();
       }
-      // Same layer - maintain registration order
-      return a.registrationOrder < b.registrationOrder;
-    });
-  
-  // Execute render commands in order
-  for (auto& cmd : renderQueue_) {
-    cmd.renderFunc();
+      activeClip = clipId;
+    }
+    Execute(cmd);
+  }
+  Renderer::EndShapeBatch();
+  if (activeClip != 0) {
+    EndScissorMode();
+  }
+}
+
+void RenderQueue::Execute(const RenderCommand &cmd) {
+  switch (cmd.kind) {
+  case RenderCommandKind::RoundedRect:
+    if (cmd.rect.lineWidth > 0.0f) {
+      Renderer::DrawRoundedRectangleEx(cmd.bounds, cmd.rect.cornerRadius,
+                                       cmd.color, cmd.rect.lineWidth);
+    } else {
+      Renderer::DrawRoundedRectangle(cmd.bounds, cmd.rect.cornerRadius,
+                                     cmd.color);
+    }
+    break;
+  case RenderCommandKind::Text:
+    Renderer::DrawText(cmd.text.text, {cmd.bounds.x, cmd.bounds.y},
+                       cmd.text.fontSize, cmd.color, cmd.text.weight);
+    break;
+  case RenderCommandKind::Icon:
+    SvgRenderer::DrawIcon(cmd.icon.name, cmd.bounds, cmd.icon.variation,
+                          cmd.color);
+    break;
+  case RenderCommandKind::Callback:
+    cmd.callback.invoke(cmd.callback.callable, cmd.bounds);
+    break;
   }
 }
 
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace raym3 {
+
+// Render order key: layer in the high half (sign bit flipped so negative
+// layers order first), registration order in the low half. The registration
+// order is also the command's index in the queue.
+inline uint64_t MakeRenderSortKey(int zOrder, int registrationOrder) {
+  uint32_t layer = static_cast<uint32_t>(zOrder) ^ 0x80000000u;
+  return (static_cast<uint64_t>(layer) << 32) |
+         static_cast<uint32_t>(registrationOrder);
+}
+
+// Stable LSD radix sort on bytes [firstByte, 8) of each key, 8 bits per
+// pass. Keys must already be ordered by the bytes below firstByte; render
+// keys are built in registration order, so sorting from byte 4 (the layer)
+// is enough. All histograms are gathered in one read, and a byte that is
+// the same in every key skips its pass, so with a handful of layers that
+// differ only in the low byte the sort is a single counting pass.
+inline void RadixSortKeys(std::vector<uint64_t> &keys,
+                          std::vector<uint64_t> &scratch, int firstByte = 4) {
+  size_t count = keys.size();
+  if (count < 2)
+    return;
+
+  constexpr int kBytes = 8;
+  uint32_t histograms[kBytes][256] = {};
+  for (uint64_t key : keys) {
+    for (int byte = firstByte; byte < kBytes; ++byte) {
+      histograms[byte][(key >> (byte * 8)) & 0xFF]++;
+    }
+  }
+
+  scratch.resize(count);
+  for (int byte = firstByte; byte < kBytes; ++byte) {
+    uint32_t *histogram = histograms[byte];
+    uint8_t first = static_cast<uint8_t>(keys[0] >> (byte * 8));
+    if (histogram[first] == count)
+      continue;
+
+    uint32_t offsets[256];
+    uint32_t total = 0;
+    for (int digit = 0; digit < 256; ++digit) {
+      offsets[digit] = total;
+      total += histogram[digit];
+    }
+    for (uint64_t key : keys) {
+      scratch[offsets[(key >> (byte * 8)) & 0xFF]++] = key;
+    }
+    keys.swap(scratch);
+  }
+}
+
+} // namespace raym3
@@ -1,9 +1,10 @@
 #include "raym3/layout/Layout.h"
-#include <map>
+#include <algorithm>
 #include <string>
 #include <vector>
 
 #if RAYM3_USE_YOGA
+#include "LayoutIdMap.h"
 #include <yoga/Yoga.h>
 
 #if RAYM3_USE_INPUT_LAYERS
@@ -12,12 +13,6 @@
 
 namespace raym3 {
 
-struct LayoutNodeInfo {
-  YGNodeRef node = nullptr;
-  Rectangle cachedBounds = {0, 0, 0, 0};
-  int id = 0;
-};
-
 struct ScrollContainerState {
   Vector2 scrollOffset = {0, 0};
   Vector2 contentSize = {0, 0};
@@ -26,114 +21,237 @@ struct ScrollContainerState {
   bool scrollY = true;
   bool isDragging = false;
   Vector2 dragStart = {0, 0};
-  int nodeId = -1;
+  LayoutId nodeId = 0;
+  uint32_t lastFrame = 0; // Frame the container was last declared in
+};
+
+// Scroll offsets outlive their node for this many frames, so a container
+// hidden briefly (a closed tab, a collapsed section) keeps its position
+constexpr uint32_t kScrollStateGraceFrames = 600;
+
+static void ApplyStyle(YGNodeRef node, const LayoutStyle &style,
+                       const LayoutStyle *previous);
+
+// Persistent per-node state, keyed by LayoutId
+struct RetainedNode {
+  YGNodeRef node = nullptr;
+  LayoutStyle style;
+  Rectangle bounds = {0, 0, 0, 0}; // Result of the last Layout::End
+  uint32_t lastFrame = 0;          // Frame the node was last declared in
+};
+
+// One level of the ID stack: a container or a PushId scope
+struct IdScope {
+  LayoutId seed = 0;
+  uint32_t childCounter = 0;
 };
 
 struct Layout::Impl {
   // Current frame state
   YGNodeRef root = nullptr;
   std::vector<YGNodeRef> nodeStack;
+  std::vector<uint32_t> childCountStack; // Children attached so far per open node
   std::vector<bool> nodeIsScrollContainer;
-  int currentNodeId = 0;
+  std::vector<IdScope> idStack;
+  uint32_t frameIndex = 0;
 
   // Scroll container stack
   std::vector<ScrollContainerState> scrollStack;
 
-  // Persistent state (mapped by ID order for simplicity in immediate mode)
-  // In a real immediate mode system, we might use a hash of the path or ID
-  // stack. For this simple implementation, we'll assume deterministic call
-  // order.
-  std::vector<Rectangle> previousFrameBounds;
-  std::vector<Rectangle> currentFrameBounds;
-  std::map<int, ScrollContainerState> scrollStates;
+  // Persistent state, keyed by hashed IDs so that adding or removing a
+  // widget only affects IDs in its own scope
+  LayoutIdMap<RetainedNode> nodes;
+  LayoutIdMap<ScrollContainerState> scrollStates;
+  std::vector<Rectangle> currentFrameBounds; // Debug draw list
+  std::vector<LayoutId> staleIds;            // Scratch for sweeping
+
+  bool retainTree = true;
+  bool sameFrameResolve = false;
+  LayoutId lastId = 0;
+  Rectangle lastRootBounds = {0, 0, -1, -1};
+  LayoutFrameStats stats;
 
   Impl() {
     // Initialize config if needed
   }
 
   ~Impl() {
+    nodes.ForEach([](LayoutId, RetainedNode &entry) {
+      if (entry.node) {
+        YGNodeFree(entry.node);
+      }
+    });
+    if (root) {
+      YGNodeFree(root);
+    }
+  }
+
+  // Frees every Yoga node but keeps cached bounds, so the next frame
+  // rebuilds the tree from scratch while still answering Alloc calls.
+  void ReleaseYogaNodes() {
+    // YGNodeFree detaches a node from its owner and children, so stale
+    // (already detached) nodes and live ones can be freed in any order.
+    nodes.ForEach([](LayoutId, RetainedNode &entry) {
+      if (entry.node) {
+        YGNodeFree(entry.node);
+        entry.node = nullptr;
+      }
+    });
     if (root) {
-      YGNodeFreeRecursive(root);
+      YGNodeFree(root);
+      root = nullptr;
     }
+    lastRootBounds = {0, 0, -1, -1};
   }
 
   void Begin(Rectangle rootBounds) {
     // Clear current frame state
-    if (root) {
-      YGNodeFreeRecursive(root);
+    if (!retainTree) {
+      ReleaseYogaNodes();
     }
     nodeStack.clear();
+    childCountStack.clear();
     nodeIsScrollContainer.clear();
     scrollStack.clear();
     currentFrameBounds.clear();
-    currentNodeId = 0;
-
-    // Create root
-    root = YGNodeNew();
-    YGNodeStyleSetWidth(root, rootBounds.width);
-    YGNodeStyleSetHeight(root, rootBounds.height);
-
-    // Default root style?
-    YGNodeStyleSetFlexDirection(root, YGFlexDirectionColumn);
+    idStack.clear();
+    idStack.push_back({HashLayoutId("##root", 0), 0});
+    lastId = 0;
+    frameIndex++;
+    stats = {};
+
+    // Create root once and only touch its size when the window changes
+    if (!root) {
+      root = YGNodeNew();
+      // Default root style?
+      YGNodeStyleSetFlexDirection(root, YGFlexDirectionColumn);
+      stats.nodesCreated++;
+    } else {
+      stats.nodesReused++;
+    }
+    if (rootBounds.width != lastRootBounds.width ||
+        rootBounds.height != lastRootBounds.height) {
+      YGNodeStyleSetWidth(root, rootBounds.width);
+      YGNodeStyleSetHeight(root, rootBounds.height);
+      lastRootBounds = rootBounds;
+    }
 
     nodeStack.push_back(root);
+    childCountStack.push_back(0);
 
     // Store root bounds as first entry
     currentFrameBounds.push_back(rootBounds);
-    currentNodeId++;
   }
 
-  void End() {
-    if (!root)
-      return;
-
-    // Calculate layout
-    YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
-
-    // Traverse and store bounds for next frame
-    StoreCalculatedBounds(root, 0, 0);
+  // ID of the next node declared in the current scope
+  LayoutId NextNodeId() {
+    IdScope &scope = idStack.back();
+    uint32_t index = scope.childCounter++;
+    LayoutId id = HashLayoutId(&index, sizeof(index), scope.seed);
+
+    // Two nodes declared with the same ID in one frame would share a Yoga
+    // node; derive a fresh ID deterministically instead.
+    RetainedNode *existing = nodes.Find(id);
+    while (existing && existing->lastFrame == frameIndex) {
+      id = HashLayoutId(&id, sizeof(id), scope.seed);
+      existing = nodes.Find(id);
+    }
+    return id;
+  }
 
-    // Swap buffers
-    previousFrameBounds = currentFrameBounds;
+  // Returns the node for id, creating it on first use and re-applying only
+  // the style fields that differ from last frame. bounds receives the
+  // previous frame's result.
+  YGNodeRef AcquireNode(LayoutId id, const LayoutStyle &style,
+                        Rectangle &bounds) {
+    RetainedNode &entry = nodes[id];
+    bool created = !entry.node;
+    bool restyled = false;
+    if (created) {
+      entry.node = YGNodeNew();
+      YGNodeSetContext(entry.node, (void *)(uintptr_t)id);
+      ApplyStyle(entry.node, style, nullptr);
+      entry.style = style;
+      stats.nodesCreated++;
+    } else {
+      stats.nodesReused++;
+      if (!(entry.style == style)) {
+        ApplyStyle(entry.node, style, &entry.style);
+        entry.style = style;
+        restyled = true;
+      }
+    }
+    entry.lastFrame = frameIndex;
+    bounds = entry.bounds;
+    lastId = id;
+
+    YGNodeRef node = entry.node;
+    bool moved = AttachToParent(node);
+    if (!created && (restyled || moved)) {
+      stats.nodesDirtied++;
+    }
+    return node;
   }
 
-  void StoreCalculatedBounds(YGNodeRef node, float parentX, float parentY) {
-    float x = parentX + YGNodeLayoutGetLeft(node);
-    float y = parentY + YGNodeLayoutGetTop(node);
-    float w = YGNodeLayoutGetWidth(node);
-    float h = YGNodeLayoutGetHeight(node);
+  // Places node at the next child index of the open parent. Returns true if
+  // the tree had to be modified (the node moved or is new to this parent).
+  bool AttachToParent(YGNodeRef node) {
+    if (nodeStack.empty()) {
+      return false;
+    }
 
-    // We already pushed the bounds in Alloc/BeginContainer order?
-    // No, we need to update them.
-    // Actually, the 'currentFrameBounds' vector was populated with placeholders
-    // or inputs. But we need to map the *calculated* bounds to the *call
-    // order*. Since we traverse the tree recursively, and we built it
-    // recursively, a preorder traversal should match the build order if we are
-    // careful.
+    YGNodeRef parent = nodeStack.back();
+    uint32_t index = childCountStack.back()++;
+    if (index < YGNodeGetChildCount(parent) &&
+        YGNodeGetChild(parent, index) == node) {
+      return false;
+    }
 
-    // Wait, the build order is:
-    // BeginContainer (Parent)
-    //   Alloc (Child 1)
-    //   Alloc (Child 2)
-    // EndContainer
+    if (YGNodeRef owner = YGNodeGetOwner(node)) {
+      YGNodeRemoveChild(owner, node);
+    }
+    YGNodeInsertChild(parent, node, index);
+    return true;
+  }
 
-    // The tree structure is:
-    // Parent -> [Child 1, Child 2]
+  // Detaches children left over from a previous frame that were not
+  // re-declared under this node this frame.
+  static void TrimChildren(YGNodeRef node, uint32_t keepCount) {
+    size_t count = YGNodeGetChildCount(node);
+    while (count > keepCount) {
+      YGNodeRemoveChild(node, YGNodeGetChild(node, count - 1));
+      count--;
+    }
+  }
 
-    // If we traverse Parent, then Child 1, then Child 2, it matches call order.
-    // So we can just iterate and fill?
-    // But we need to write to the correct index.
-    // Let's just rebuild the list during traversal?
-    // No, 'currentFrameBounds' was used to store the *result*?
-    // Let's clear 'currentFrameBounds' at End() and refill it.
+  // Frees nodes that were not declared this frame, and scroll state whose
+  // container has been absent for longer than the grace period
+  void SweepStaleNodes() {
+    staleIds.clear();
+    nodes.ForEach([&](LayoutId id, RetainedNode &entry) {
+      if (entry.lastFrame != frameIndex) {
+        staleIds.push_back(id);
+      }
+    });
+    for (LayoutId id : staleIds) {
+      if (RetainedNode *entry = nodes.Find(id)) {
+        if (entry->node) {
+          YGNodeFree(entry->node);
+        }
+      }
+      nodes.Erase(id);
+    }
 
-    // Actually, let's use a separate vector for results.
+    staleIds.clear();
+    scrollStates.ForEach([&](LayoutId id, ScrollContainerState &state) {
+      if (frameIndex - state.lastFrame > kScrollStateGraceFrames) {
+        staleIds.push_back(id);
+      }
+    });
+    for (LayoutId id : staleIds) {
+      scrollStates.Erase(id);
+    }
   }
-
-  // Revised strategy for bounds storage:
-  // We need to store the bounds *as we calculate them* at the end of the frame,
-  // so they are ready for the *next* frame's Begin/Alloc calls.
-  // The Begin/Alloc calls read from 'previousFrameBounds' using an index.
 };
 
 // Static instance
@@ -142,99 +260,120 @@ std::unique_ptr<Layout::Impl> Layout::impl_ = std::make_unique<Layout::Impl>();
 // We need to implement the traversal properly in End().
 // But first, let's implement the helpers.
 
-static void ApplyStyle(YGNodeRef node, LayoutStyle style) {
-  if (style.width >= 0)
-    YGNodeStyleSetWidth(node, style.width);
-  if (style.height >= 0)
-    YGNodeStyleSetHeight(node, style.height);
+// Applies style to node. For a fresh node pass previous = nullptr; for a
+// recycled node pass last frame's style so only changed fields are written
+// (Yoga marks the node dirty on every setter that changes a value).
+static void ApplyStyle(YGNodeRef node, const LayoutStyle &style,
+                       const LayoutStyle *previous) {
+  auto changed = [&](auto LayoutStyle::*field) {
+    return !previous || previous->*field != style.*field;
+  };
+
+  if (changed(&LayoutStyle::width)) {
+    if (style.width >= 0)
+      YGNodeStyleSetWidth(node, style.width);
+    else if (previous)
+      YGNodeStyleSetWidthAuto(node);
+  }
+  if (changed(&LayoutStyle::height)) {
+    if (style.height >= 0)
+      YGNodeStyleSetHeight(node, style.height);
+    else if (previous)
+      YGNodeStyleSetHeightAuto(node);
+  }
 
-  YGNodeStyleSetFlexGrow(node, style.flexGrow);
-  YGNodeStyleSetFlexShrink(node, style.flexShrink);
+  if (changed(&LayoutStyle::flexGrow))
+    YGNodeStyleSetFlexGrow(node, style.flexGrow);
+  if (changed(&LayoutStyle::flexShrink))
+    YGNodeStyleSetFlexShrink(node, style.flexShrink);
 
-  if (style.padding > 0)
-    YGNodeStyleSetPadding(node, YGEdgeAll, style.padding);
-  if (style.gap > 0)
-    YGNodeStyleSetGap(node, YGGutterAll, style.gap);
+  if (changed(&LayoutStyle::padding) && (style.padding > 0 || previous))
+    YGNodeStyleSetPadding(node, YGEdgeAll, std::max(style.padding, 0.0f));
+  if (changed(&LayoutStyle::gap) && (style.gap > 0 || previous))
+    YGNodeStyleSetGap(node, YGGutterAll, std::max(style.gap, 0.0f));
 
   // Direction
-  if (style.direction == 0)
-    YGNodeStyleSetFlexDirection(node, YGFlexDirectionRow);
-  else
-    YGNodeStyleSetFlexDirection(node, YGFlexDirectionColumn);
+  if (changed(&LayoutStyle::direction)) {
+    if (style.direction == 0)
+      YGNodeStyleSetFlexDirection(node, YGFlexDirectionRow);
+    else
+      YGNodeStyleSetFlexDirection(node, YGFlexDirectionColumn);
+  }
 
   // Justify
-  switch (style.justify) {
-  case 0:
-    YGNodeStyleSetJustifyContent(node, YGJustifyFlexStart);
-    break;
-  case 1:
-    YGNodeStyleSetJustifyContent(node, YGJustifyCenter);
-    break;
-  case 2:
-    YGNodeStyleSetJustifyContent(node, YGJustifyFlexEnd);
-    break;
-  case 3:
-    YGNodeStyleSetJustifyContent(node, YGJustifySpaceBetween);
-    break;
-  case 4:
-    YGNodeStyleSetJustifyContent(node, YGJustifySpaceAround);
-    break;
-  case 5:
-    YGNodeStyleSetJustifyContent(node, YGJustifySpaceEvenly);
-    break;
+  if (changed(&LayoutStyle::justify)) {
+    switch (style.justify) {
+    case 0:
+      YGNodeStyleSetJustifyContent(node, YGJustifyFlexStart);
+      break;
+    case 1:
+      YGNodeStyleSetJustifyContent(node, YGJustifyCenter);
+      break;
+    case 2:
+      YGNodeStyleSetJustifyContent(node, YGJustifyFlexEnd);
+      break;
+    case 3:
+      YGNodeStyleSetJustifyContent(node, YGJustifySpaceBetween);
+      break;
+    case 4:
+      YGNodeStyleSetJustifyContent(node, YGJustifySpaceAround);
+      break;
+    case 5:
+      YGNodeStyleSetJustifyContent(node, YGJustifySpaceEvenly);
+      break;
+    }
   }
 
   // Align Items
-  switch (style.align) {
-  case 0:
-    YGNodeStyleSetAlignItems(node, YGAlignStretch);
-    break;
-  case 1:
-    YGNodeStyleSetAlignItems(node, YGAlignFlexStart);
-    break;
-  case 2:
-    YGNodeStyleSetAlignItems(node, YGAlignCenter);
-    break;
-  case 3:
-    YGNodeStyleSetAlignItems(node, YGAlignFlexEnd);
-    break;
-  case 4:
-    YGNodeStyleSetAlignItems(node, YGAlignStretch);
-    break;
+  if (changed(&LayoutStyle::align)) {
+    switch (style.align) {
+    case 0:
+      YGNodeStyleSetAlignItems(node, YGAlignStretch);
+      break;
+    case 1:
+      YGNodeStyleSetAlignItems(node, YGAlignFlexStart);
+      break;
+    case 2:
+      YGNodeStyleSetAlignItems(node, YGAlignCenter);
+      break;
+    case 3:
+      YGNodeStyleSetAlignItems(node, YGAlignFlexEnd);
+      break;
+    case 4:
+      YGNodeStyleSetAlignItems(node, YGAlignStretch);
+      break;
+    }
   }
 
   // Flex Wrap
-  switch (style.flexWrap) {
-  case 0:
-    YGNodeStyleSetFlexWrap(node, YGWrapNoWrap);
-    break;
-  case 1:
-    YGNodeStyleSetFlexWrap(node, YGWrapWrap);
-    break;
-  case 2:
-    YGNodeStyleSetFlexWrap(node, YGWrapWrapReverse);
-    break;
+  if (changed(&LayoutStyle::flexWrap)) {
+    switch (style.flexWrap) {
+    case 0:
+      YGNodeStyleSetFlexWrap(node, YGWrapNoWrap);
+      break;
+    case 1:
+      YGNodeStyleSetFlexWrap(node, YGWrapWrap);
+      break;
+    case 2:
+      YGNodeStyleSetFlexWrap(node, YGWrapWrapReverse);
+      break;
+    }
   }
 }
 
 Rectangle Layout::BeginContainer(LayoutStyle style) {
-  YGNodeRef node = YGNodeNew();
-  ApplyStyle(node, style);
-
-  // Add to current parent
-  if (!impl_->nodeStack.empty()) {
-    YGNodeRef parent = impl_->nodeStack.back();
-    YGNodeInsertChild(parent, node, YGNodeGetChildCount(parent));
-  }
+  // Recycle last frame's node for this ID and attach it to the parent
+  LayoutId id = impl_->NextNodeId();
+  Rectangle bounds;
+  YGNodeRef node = impl_->AcquireNode(id, style, bounds);
 
   impl_->nodeStack.push_back(node);
+  impl_->childCountStack.push_back(0);
+  impl_->nodeIsScrollContainer.push_back(false);
+  impl_->idStack.push_back({id, 0});
 
-  // Return bounds from previous frame
-  int id = impl_->currentNodeId++;
-  if (id < impl_->previousFrameBounds.size()) {
-    return impl_->previousFrameBounds[id];
-  }
-  return {0, 0, 0, 0}; // Default if new
+  // Bounds from previous frame ({0,0,0,0} if new)
+  return bounds;
 }
 
 void Layout::EndContainer() {
@@ -248,7 +387,14 @@ void Layout::EndContainer() {
       }
     }
 
+    // Drop children that were declared last frame but not this one
+    Impl::TrimChildren(impl_->nodeStack.back(), impl_->childCountStack.back());
+
     impl_->nodeStack.pop_back();
+    impl_->childCountStack.pop_back();
+    if (impl_->idStack.size() > 1) {
+      impl_->idStack.pop_back();
+    }
     if (!impl_->nodeIsScrollContainer.empty()) {
       impl_->nodeIsScrollContainer.pop_back();
     }
@@ -256,20 +402,14 @@ void Layout::EndContainer() {
 }
 
 Rectangle Layout::Alloc(LayoutStyle style) {
-  YGNodeRef node = YGNodeNew();
-  ApplyStyle(node, style);
+  LayoutId id = impl_->NextNodeId();
+  Rectangle bounds;
+  YGNodeRef node = impl_->AcquireNode(id, style, bounds);
 
-  if (!impl_->nodeStack.empty()) {
-    YGNodeRef parent = impl_->nodeStack.back();
-    YGNodeInsertChild(parent, node, YGNodeGetChildCount(parent));
-  }
+  // A recycled leaf may have been a container last frame
+  Impl::TrimChildren(node, 0);
 
-  // Return bounds
-  int id = impl_->currentNodeId++;
-  if (id < impl_->previousFrameBounds.size()) {
-    return impl_->previousFrameBounds[id];
-  }
-  return {0, 0, 0, 0};
+  return bounds;
 }
 
 // Helpers
@@ -300,16 +440,21 @@ void Layout::End() {
   if (!impl_->root)
     return;
 
+  // Close anything left open, including the root, so stale children from
+  // the previous frame are detached before layout
+  while (!impl_->nodeStack.empty()) {
+    Impl::TrimChildren(impl_->nodeStack.back(), impl_->childCountStack.back());
+    impl_->nodeStack.pop_back();
+    impl_->childCountStack.pop_back();
+  }
+  impl_->idStack.clear();
+
   YGNodeCalculateLayout(impl_->root, YGUndefined, YGUndefined, YGDirectionLTR);
 
   impl_->currentFrameBounds.clear();
 
-  // Track node index for matching with scroll states
-  int nodeIndex = 0;
-
   // Recursive lambda
-  auto traverse = [&](auto &&self, YGNodeRef node, float x, float y,
-                      int &idx) -> void {
+  auto traverse = [&](auto &&self, YGNodeRef node, float x, float y) -> void {
     float left = YGNodeLayoutGetLeft(node);
     float top = YGNodeLayoutGetTop(node);
     float width = YGNodeLayoutGetWidth(node);
@@ -318,15 +463,21 @@ void Layout::End() {
     float absX = x + left;
     float absY = y + top;
 
-    int currentIdx = idx++;
     impl_->currentFrameBounds.push_back({absX, absY, width, height});
 
-    uint32_t count = YGNodeGetChildCount(node); // Moved declaration up
+    // Every node but the root carries its LayoutId as context
+    LayoutId id = (LayoutId)(uintptr_t)YGNodeGetContext(node);
+    if (RetainedNode *entry = impl_->nodes.Find(id)) {
+      entry->bounds = {absX, absY, width, height};
+    }
+
+    uint32_t count = YGNodeGetChildCount(node);
 
     // Check if this node is a scroll container
     Vector2 scrollOffset = {0, 0};
-    if (impl_->scrollStates.count(currentIdx)) {
-      auto &scrollState = impl_->scrollStates[currentIdx];
+    ScrollContainerState *found = impl_->scrollStates.Find(id);
+    if (found && found->lastFrame == impl_->frameIndex) {
+      auto &scrollState = *found;
       scrollOffset = scrollState.scrollOffset;
 
       // Calculate content size by measuring children
@@ -380,42 +531,34 @@ void Layout::End() {
     for (uint32_t i = 0; i < count; ++i) {
       // Apply scroll offset to children
       self(self, YGNodeGetChild(node, i), absX + scrollOffset.x,
-           absY + scrollOffset.y, idx);
+           absY + scrollOffset.y);
     }
   };
 
   // Start traversal.
-  traverse(traverse, impl_->root, rootOffsetX, rootOffsetY, nodeIndex);
+  traverse(traverse, impl_->root, rootOffsetX, rootOffsetY);
 
-  impl_->previousFrameBounds = impl_->currentFrameBounds;
+  // Forget widgets that were not declared this frame
+  impl_->SweepStaleNodes();
 }
 
 Rectangle Layout::BeginScrollContainer(LayoutStyle style, bool scrollX,
                                        bool scrollY) {
-  // Create the container node
-  YGNodeRef node = YGNodeNew();
-  ApplyStyle(node, style);
-
   // For scroll containers, we need to allow content to overflow
   // So we don't constrain the height (let children determine it)
   if (scrollX) {
-    YGNodeStyleSetWidth(node, YGUndefined);
+    style.width = -1.0f;
   }
 
-  if (!impl_->nodeStack.empty()) {
-    YGNodeRef parent = impl_->nodeStack.back();
-    YGNodeInsertChild(parent, node, YGNodeGetChildCount(parent));
-  }
+  // Create (or recycle) the container node; bounds are from previous frame
+  LayoutId id = impl_->NextNodeId();
+  Rectangle bounds;
+  YGNodeRef node = impl_->AcquireNode(id, style, bounds);
 
   impl_->nodeStack.push_back(node);
+  impl_->childCountStack.push_back(0);
   impl_->nodeIsScrollContainer.push_back(true);
-
-  // Get bounds from previous frame
-  int id = impl_->currentNodeId++;
-  Rectangle bounds = {0, 0, 0, 0};
-  if (id < impl_->previousFrameBounds.size()) {
-    bounds = impl_->previousFrameBounds[id];
-  }
+  impl_->idStack.push_back({id, 0});
 
   // If bounds are invalid (first frame), use screen bounds as fallback
   // This ensures scissor mode is always set up, and bounds will be corrected on
@@ -430,12 +573,16 @@ Rectangle Layout::BeginScrollContainer(LayoutStyle style, bool scrollX,
   scrollState.bounds = bounds;
   scrollState.scrollX = scrollX;
   scrollState.scrollY = scrollY;
-
-  // Restore scroll offset from previous frame if exists
-  if (impl_->scrollStates.count(id)) {
-    scrollState.scrollOffset = impl_->scrollStates[id].scrollOffset;
-    scrollState.isDragging = impl_->scrollStates[id].isDragging;
-    scrollState.dragStart = impl_->scrollStates[id].dragStart;
+  scrollState.lastFrame = impl_->frameIndex;
+
+  // Restore scroll offset from the last frame the container was declared
+  // in; a drag only carries over from the previous frame
+  if (const ScrollContainerState *previous = impl_->scrollStates.Find(id)) {
+    scrollState.scrollOffset = previous->scrollOffset;
+    if (previous->lastFrame + 1 == impl_->frameIndex) {
+      scrollState.isDragging = previous->isDragging;
+      scrollState.dragStart = previous->dragStart;
+    }
   }
 
   // Handle input
@@ -524,7 +671,7 @@ Vector2 Layout::GetScrollOffset() {
 void Layout::SetScrollOffset(Vector2 offset) {
   if (!impl_->scrollStack.empty()) {
     impl_->scrollStack.back().scrollOffset = offset;
-    int id = impl_->scrollStack.back().nodeId;
+    LayoutId id = impl_->scrollStack.back().nodeId;
     impl_->scrollStates[id].scrollOffset = offset;
   }
 }
@@ -543,6 +690,75 @@ bool Layout::IsRectVisibleInScrollContainer(Rectangle rect) {
   return CheckCollisionRecs(rect, scissorBounds);
 }
 
+Rectangle Layout::GetActiveScissorBounds() {
+  Rectangle clip = {0, 0, (float)GetScreenWidth(), (float)GetScreenHeight()};
+  for (const ScrollContainerState &scrollState : impl_->scrollStack) {
+    float x0 = std::max(clip.x, scrollState.bounds.x);
+    float y0 = std::max(clip.y, scrollState.bounds.y);
+    float x1 = std::min(clip.x + clip.width,
+                        scrollState.bounds.x + scrollState.bounds.width);
+    float y1 = std::min(clip.y + clip.height,
+                        scrollState.bounds.y + scrollState.bounds.height);
+    clip = {x0, y0, std::max(0.0f, x1 - x0), std::max(0.0f, y1 - y0)};
+  }
+  return clip;
+}
+
+void Layout::PushId(const char *str) {
+  LayoutId id = GetId(str);
+  impl_->idStack.push_back({id, 0});
+}
+
+void Layout::PushId(const void *ptr) {
+  LayoutId seed = impl_->idStack.empty() ? 0 : impl_->idStack.back().seed;
+  impl_->idStack.push_back({HashLayoutId(&ptr, sizeof(ptr), seed), 0});
+}
+
+void Layout::PushId(int value) {
+  LayoutId seed = impl_->idStack.empty() ? 0 : impl_->idStack.back().seed;
+  impl_->idStack.push_back({HashLayoutId(&value, sizeof(value), seed), 0});
+}
+
+void Layout::PopId() {
+  // Never pop the root scope
+  if (impl_->idStack.size() > 1) {
+    impl_->idStack.pop_back();
+  }
+}
+
+LayoutId Layout::GetId(const char *str) {
+  LayoutId seed = impl_->idStack.empty() ? 0 : impl_->idStack.back().seed;
+  return HashLayoutId(str, seed);
+}
+
+void Layout::SetSameFrameResolve(bool enabled) {
+  impl_->sameFrameResolve = enabled;
+}
+
+bool Layout::IsSameFrameResolve() { return impl_->sameFrameResolve; }
+
+LayoutId Layout::GetLastId() { return impl_->lastId; }
+
+LayoutId Layout::GetScrollContainerId() {
+  if (impl_->scrollStack.empty()) {
+    return 0;
+  }
+  return impl_->scrollStack.back().nodeId;
+}
+
+Rectangle Layout::GetBounds(LayoutId id) {
+  if (const RetainedNode *entry = impl_->nodes.Find(id)) {
+    return entry->bounds;
+  }
+  return {0, 0, 0, 0};
+}
+
+void Layout::SetRetainedTree(bool enabled) { impl_->retainTree = enabled; }
+
+bool Layout::IsRetainedTree() { return impl_->retainTree; }
+
+LayoutFrameStats Layout::GetFrameStats() { return impl_->stats; }
+
 static bool debugEnabled = false;
 
 void Layout::SetDebug(bool enabled) { debugEnabled = enabled; }
@@ -624,6 +840,36 @@ void Layout::SetScrollOffset(Vector2) {}
 
 bool Layout::IsRectVisibleInScrollContainer(Rectangle) { return true; }
 
+Rectangle Layout::GetActiveScissorBounds() {
+  return {0, 0, (float)GetScreenWidth(), (float)GetScreenHeight()};
+}
+
+void Layout::PushId(const char *) {}
+
+void Layout::PushId(const void *) {}
+
+void Layout::PushId(int) {}
+
+void Layout::PopId() {}
+
+LayoutId Layout::GetId(const char *) { return 0; }
+
+void Layout::SetSameFrameResolve(bool) {}
+
+bool Layout::IsSameFrameResolve() { return false; }
+
+LayoutId Layout::GetLastId() { return 0; }
+
+LayoutId Layout::GetScrollContainerId() { return 0; }
+
+Rectangle Layout::GetBounds(LayoutId) { return {0, 0, 0, 0}; }
+
+void Layout::SetRetainedTree(bool) {}
+
+bool Layout::IsRetainedTree() { return false; }
+
+LayoutFrameStats Layout::GetFrameStats() { return {}; }
+
 LayoutStyle Layout::Row() { return LayoutStyle{.direction = 0}; }
 
 LayoutStyle Layout::Column() { return LayoutStyle{.direction = 1}; }
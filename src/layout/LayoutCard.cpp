@@ -1,5 +1,7 @@
 #include "raym3/layout/LayoutCard.h"
 #include "raym3/raym3.h"
+#include "raym3/rendering/Renderer.h"
+#include <algorithm>
 
 namespace raym3 {
 
@@ -17,12 +19,12 @@ Rectangle LayoutCard::BeginCard(LayoutStyle style, CardVariant variant) {
   if (bounds.width > 0 && bounds.height > 0) {
     ColorScheme &scheme = Theme::GetColorScheme();
     Color cardColor;
-    float elevation = 0;
+    int elevation = 0;
 
     switch (variant) {
     case CardVariant::Elevated:
       cardColor = scheme.surfaceContainerLow;
-      elevation = 1.0f;
+      elevation = 1;
       break;
     case CardVariant::Filled:
       cardColor = scheme.surfaceContainerHighest;
@@ -34,24 +36,17 @@ Rectangle LayoutCard::BeginCard(LayoutStyle style, CardVariant variant) {
       break;
     }
 
-    // Draw shadow for elevated cards
-    if (elevation > 0) {
-      Color shadowColor = {0, 0, 0, 30};
-      DrawRectangleRounded(
-          {bounds.x + 2, bounds.y + 2, bounds.width, bounds.height}, 0.15f, 10,
-          shadowColor);
-    }
+    // Matches the previous raylib roundness of 0.15
+    float cornerRadius = std::min(bounds.width, bounds.height) * 0.075f;
 
-    // Draw card background
-    DrawRectangleRounded(bounds, 0.15f, 10, cardColor);
+    // Draw card background (with the cached elevation shadow)
+    Renderer::DrawElevatedRectangle(bounds, cornerRadius, elevation,
+                                    cardColor);
 
     // Draw outline for outlined variant
     if (variant == CardVariant::Outlined) {
-#ifdef PLATFORM_ANDROID
-      DrawRectangleRoundedLinesEx(bounds, 0.15f, 10, 1.0f, scheme.outlineVariant);
-#else
-      DrawRectangleRoundedLines(bounds, 0.15f, 10, scheme.outlineVariant);
-#endif
+      Renderer::DrawRoundedRectangleEx(bounds, cornerRadius,
+                                       scheme.outlineVariant, 1.0f);
     }
   }
 
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "raym3/layout/Layout.h"
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace raym3 {
+
+// FNV-1a over raw bytes, chained from a parent seed so the same key under
+// different ID scopes yields different IDs. 0 is reserved for "no id".
+inline LayoutId HashLayoutId(const void *data, size_t size, LayoutId seed) {
+  uint32_t hash = seed ? seed : 2166136261u;
+  const unsigned char *bytes = static_cast<const unsigned char *>(data);
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= bytes[i];
+    hash *= 16777619u;
+  }
+  return hash ? hash : 1u;
+}
+
+inline LayoutId HashLayoutId(const char *str, LayoutId seed) {
+  uint32_t hash = seed ? seed : 2166136261u;
+  for (const unsigned char *c = (const unsigned char *)str; c && *c; ++c) {
+    hash ^= *c;
+    hash *= 16777619u;
+  }
+  return hash ? hash : 1u;
+}
+
+// Open-addressing (linear probing) hash map from LayoutId to T. Capacity is
+// a power of two and key 0 marks an empty slot; erase uses backward-shift
+// deletion so there are no tombstones and lookups stay short.
+template <typename T> class LayoutIdMap {
+public:
+  T *Find(LayoutId key) {
+    if (keys_.empty() || key == 0)
+      return nullptr;
+    size_t mask = keys_.size() - 1;
+    for (size_t i = key & mask;; i = (i + 1) & mask) {
+      if (keys_[i] == key)
+        return &values_[i];
+      if (keys_[i] == 0)
+        return nullptr;
+    }
+  }
+
+  // Returns the value for key, default-constructing it if missing
+  T &operator[](LayoutId key) {
+    if ((count_ + 1) * 4 > keys_.size() * 3) {
+      Grow();
+    }
+    size_t mask = keys_.size() - 1;
+    size_t i = key & mask;
+    while (keys_[i] != 0 && keys_[i] != key) {
+      i = (i + 1) & mask;
+    }
+    if (keys_[i] == 0) {
+      keys_[i] = key;
+      values_[i] = T{};
+      count_++;
+    }
+    return values_[i];
+  }
+
+  bool Contains(LayoutId key) { return Find(key) != nullptr; }
+
+  void Erase(LayoutId key) {
+    if (keys_.empty() || key == 0)
+      return;
+    size_t mask = keys_.size() - 1;
+    size_t i = key & mask;
+    while (keys_[i] != key) {
+      if (keys_[i] == 0)
+        return;
+      i = (i + 1) & mask;
+    }
+
+    // Shift following entries of the probe run back into the hole
+    size_t hole = i;
+    for (size_t j = (hole + 1) & mask; keys_[j] != 0; j = (j + 1) & mask) {
+      size_t home = keys_[j] & mask;
+      bool canMove = (hole <= j) ? (home <= hole || home > j)
+                                 : (home <= hole && home > j);
+      if (canMove) {
+        keys_[hole] = keys_[j];
+        values_[hole] = std::move(values_[j]);
+        hole = j;
+      }
+    }
+    keys_[hole] = 0;
+    values_[hole] = T{};
+    count_--;
+  }
+
+  void Clear() {
+    std::fill(keys_.begin(), keys_.end(), 0);
+    for (T &value : values_)
+      value = T{};
+    count_ = 0;
+  }
+
+  size_t Size() const { return count_; }
+
+  template <typename Fn> void ForEach(Fn &&fn) {
+    for (size_t i = 0; i < keys_.size(); ++i) {
+      if (keys_[i] != 0)
+        fn(keys_[i], values_[i]);
+    }
+  }
+
+private:
+  std::vector<LayoutId> keys_;
+  std::vector<T> values_;
+  size_t count_ = 0;
+
+  void Grow() {
+    std::vector<LayoutId> oldKeys = std::move(keys_);
+    std::vector<T> oldValues = std::move(values_);
+    size_t capacity = oldKeys.empty() ? 64 : oldKeys.size() * 2;
+    keys_.assign(capacity, 0);
+    values_.clear();
+    values_.resize(capacity);
+    count_ = 0;
+    for (size_t i = 0; i < oldKeys.size(); ++i) {
+      if (oldKeys[i] != 0)
+        (*this)[oldKeys[i]] = std::move(oldValues[i]);
+    }
+  }
+};
+
+} // namespace raym3
@@ -19,6 +19,7 @@
 #include "raym3/components/RadioButton.h"
 #include "raym3/components/SegmentedButton.h"
 #include "raym3/components/Text.h"
+#include "raym3/rendering/Renderer.h"
 #include "raym3/rendering/SvgRenderer.h"
 
 #if RAYM3_USE_INPUT_LAYERS
@@ -51,6 +52,7 @@ void Shutdown() {
     return;
 
   SvgRenderer::Shutdown();
+  Renderer::Shutdown();
   Theme::Shutdown();
   initialized = false;
 }
@@ -61,6 +63,8 @@ void BeginFrame() {
   TextFieldComponent::ResetFieldId();
   SliderComponent::ResetFieldId();
   RangeSliderComponent::ResetFieldId();
+  SvgRenderer::ProcessPendingUploads();
+  Theme::UpdateTransition(GetFrameTime());
 
 #if RAYM3_USE_INPUT_LAYERS
   InputLayerManager::BeginFrame();
@@ -97,6 +101,12 @@ void SetTheme(bool isDarkMode) {
 
 bool IsDarkMode() { return darkMode; }
 
+void SetThemeTransition(float seconds) {
+  Theme::SetTransitionDuration(seconds);
+}
+
+void SetSeedColor(Color seedColor) { Theme::SetSeedColor(seedColor); }
+
 void SetIconBasePath(const char *path) { SvgRenderer::Initialize(path); }
 
 void BeginContainer(Rectangle bounds, LayoutDirection direction) {
@@ -163,6 +173,12 @@ void Text(const char *text, Rectangle bounds, float fontSize, Color color,
   TextComponent::Render(text, bounds, fontSize, color, weight, alignment);
 }
 
+Vector2 Text(const char *text, Rectangle bounds, float fontSize, Color color,
+             FontWeight weight, const TextLayoutOptions &options) {
+  return TextComponent::RenderWrapped(text, bounds, fontSize, color, weight,
+                                      options);
+}
+
 void CircularProgressIndicator(Rectangle bounds, float value,
                                bool indeterminate, Color color,
                                float wiggleAmplitude, float wiggleFrequency) {
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace raym3 {
+
+// Pre-parsed icon data emitted by tools/icon_pack.cpp. Every table is a
+// constexpr array, so an embedded pack costs nothing at static-init time
+// and icons are rebuilt into NSVGimages without parsing XML.
+
+struct IconPackPath {
+  uint32_t firstPoint; // Index into IconPack::points (x, y pairs)
+  uint32_t pointCount; // Cubic bezier points, as in NSVGpath::npts
+  uint8_t closed;
+};
+
+struct IconPackShape {
+  uint32_t firstPath;
+  uint32_t pathCount;
+  uint32_t fillColor;   // 0xAABBGGRR, as in NSVGpaint::color
+  uint32_t strokeColor; // 0xAABBGGRR
+  float opacity;
+  float strokeWidth;
+  float miterLimit;
+  uint8_t fillType; // NSVGpaintType (gradients are baked to none)
+  uint8_t strokeType;
+  uint8_t fillRule;
+  uint8_t strokeLineJoin;
+  uint8_t strokeLineCap;
+  uint8_t paintOrder;
+};
+
+struct IconPackEntry {
+  const char *key; // "variation/name", entries are sorted by key
+  float width;
+  float height;
+  uint32_t firstShape;
+  uint32_t shapeCount;
+};
+
+struct IconPack {
+  const IconPackEntry *entries;
+  size_t entryCount;
+  const IconPackShape *shapes;
+  const IconPackPath *paths;
+  const float *points;
+};
+
+// Binary search over the sorted entry table
+inline const IconPackEntry *FindPackedIcon(const IconPack &pack,
+                                           std::string_view key) {
+  size_t lo = 0;
+  size_t hi = pack.entryCount;
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    int cmp = key.compare(pack.entries[mid].key);
+    if (cmp == 0)
+      return &pack.entries[mid];
+    if (cmp < 0) {
+      hi = mid;
+    } else {
+      lo = mid + 1;
+    }
+  }
+  return nullptr;
+}
+
+} // namespace raym3
@@ -1,26 +1,616 @@
 #include "raym3/rendering/Renderer.h"
 #include "raym3/fonts/FontManager.h"
 #include "raym3/styles/Theme.h"
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <rlgl.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace raym3 {
 
-void Renderer::DrawRoundedRectangle(Rectangle bounds, float cornerRadius,
-                                    Color color) {
-  float minDim = std::min(bounds.width, bounds.height);
+namespace {
+
+// Glyph advances of one loaded font in font.baseSize units, computed the
+// same way MeasureTextEx does (advanceX, or rec width + offsetX if zero)
+struct FontAdvances {
+  Font font = {0};
+  float ascii[128] = {};
+  std::unordered_map<int, float> other;
+};
+
+// Measurements are dropped wholesale past this count, which only happens
+// with lots of dynamic text (e.g. typing into a field)
+constexpr size_t kMaxMeasureEntries = 4096;
+
+// What a measurement was taken of. Caches are keyed by MeasureKey, and a
+// hit is confirmed against this, so a hash collision is a miss instead of
+// another string's measurements.
+struct MeasureSource {
+  std::string text;
+  float fontSize = 0.0f;
+  FontWeight weight = FontWeight::Regular;
+
+  bool Matches(const char *other, float size, FontWeight w) const {
+    return fontSize == size && weight == w && text == other;
+  }
+  void Assign(const char *other, float size, FontWeight w) {
+    text.assign(other); // Reuses the capacity of a recycled entry
+    fontSize = size;
+    weight = w;
+  }
+};
+
+struct MeasureEntry {
+  MeasureSource source;
+  Vector2 size;
+};
+
+std::unordered_map<uint32_t, FontAdvances> s_fontAdvances;
+std::unordered_map<uint64_t, MeasureEntry> s_measureCache;
+TextMeasureStats s_measureStats;
+
+// Prefix advance arrays for the last few strings, reused round-robin so the
+// steady state allocates nothing
+struct PrefixSlot {
+  uint64_t key = 0;
+  MeasureSource source;
+  std::vector<float> x;
+  std::vector<int> byteOffsets;
+};
+
+constexpr int kPrefixSlots = 16;
+PrefixSlot s_prefixSlots[kPrefixSlots];
+int s_nextPrefixSlot = 0;
+// Slot whose arrays were returned last; cache clears leave it intact so a
+// caller's TextAdvances survives glyph loads triggered by other text
+int s_lastPrefixSlot = -1;
+
+uint32_t s_glyphGeneration = 0;
+
+// Drops everything built from Font copies once FontManager has added glyphs
+// or moved a glyph page
+void SyncGlyphGeneration() {
+  uint32_t generation = FontManager::GetGlyphGeneration();
+  if (generation != s_glyphGeneration) {
+    Renderer::ClearTextMeasureCache();
+    s_glyphGeneration = generation;
+  }
+}
+
+// Loads glyphs for codepoints outside the baked set before text is drawn or
+// measured
+void PrepareGlyphs(const char *text, float fontSize, FontWeight weight) {
+  if (FontManager::RequestGlyphs(weight, static_cast<int>(fontSize), text)) {
+    SyncGlyphGeneration();
+  }
+}
+
+float ComputeGlyphAdvance(const Font &font, int codepoint) {
+  int index = GetGlyphIndex(font, codepoint);
+  if (font.glyphs[index].advanceX != 0)
+    return (float)font.glyphs[index].advanceX;
+  return font.recs[index].width + (float)font.glyphs[index].offsetX;
+}
+
+float GlyphAdvance(FontAdvances &advances, int codepoint) {
+  if (codepoint >= 0 && codepoint < 128)
+    return advances.ascii[codepoint];
+  auto it = advances.other.find(codepoint);
+  if (it != advances.other.end())
+    return it->second;
+  float advance = ComputeGlyphAdvance(advances.font, codepoint);
+  advances.other.emplace(codepoint, advance);
+  return advance;
+}
+
+// Same font selection as Theme::GetFont: one font per (weight, int size)
+FontAdvances *GetFontAdvances(float fontSize, FontWeight weight) {
+  uint32_t key = (static_cast<uint32_t>(weight) << 16) |
+                 (static_cast<uint32_t>(static_cast<int>(fontSize)) & 0xFFFF);
+  auto it = s_fontAdvances.find(key);
+  if (it != s_fontAdvances.end())
+    return &it->second;
+
+  Font font = Theme::GetFont(fontSize, weight);
+  if (font.texture.id == 0 || font.glyphs == nullptr)
+    return nullptr;
+
+  FontAdvances &advances = s_fontAdvances[key];
+  advances.font = font;
+  for (int c = 0; c < 128; ++c) {
+    advances.ascii[c] = ComputeGlyphAdvance(font, c);
+  }
+  return &advances;
+}
+
+// FNV-1a over the string, the size bits and the weight
+uint64_t MeasureKey(const char *text, float fontSize, FontWeight weight) {
+  uint64_t hash = 14695981039346656037ull;
+  for (const unsigned char *c = (const unsigned char *)text; *c; ++c) {
+    hash ^= *c;
+    hash *= 1099511628211ull;
+  }
+  uint32_t sizeBits;
+  std::memcpy(&sizeBits, &fontSize, sizeof(sizeBits));
+  hash ^= sizeBits;
+  hash *= 1099511628211ull;
+  hash ^= static_cast<uint64_t>(weight);
+  hash *= 1099511628211ull;
+  return hash;
+}
+
+// SDF shapes: every rounded rectangle, outline and state layer is a single
+// quad whose coverage is computed per pixel, so a frame's shapes share the
+// raylib batch (and draw call) instead of each being a 16-segment fan.
+//
+// The shader stays bound between shapes so the batch is not flushed; other
+// vertices pass through it unchanged. A shape vertex is recognized by a
+// negative normal z together with a position z at or below -kShapeDepthBase:
+//   texcoord   position relative to the rectangle center, in pixels
+//   normal     (halfWidth - radius, halfHeight - radius, -1); only the ratios
+//              are read since rlgl may normalize normals
+//   position z -(kShapeDepthBase + lineQuarters * 2048 + radius), reset to 0
+//              by the vertex shader
+// Distance field textures (SvgRenderer's SDF icons) use the same depth
+// marker with a positive normal z: normal (smoothing, 0, 1), position z
+// -kShapeDepthBase. Their alpha is the distance, 0.5 on the edge.
+constexpr float kShapeDepthBase = 1048576.0f; // 2^20
+constexpr float kShapeMaxRadius = 2047.0f;
+constexpr float kShapeMaxLineWidth = 63.75f;
+
+Shader s_shapeShader = {0};
+bool s_shapeShaderLoaded = false;
+bool s_shapeShaderBound = false;
+bool s_shapeBatchOpen = false; // Between BeginShapeBatch and EndShapeBatch
+bool s_sdfShapes = true;
+
+const char *shapeVertShader330 = R"(
+#version 330
+in vec3 vertexPosition;
+in vec2 vertexTexCoord;
+in vec3 vertexNormal;
+in vec4 vertexColor;
+
+uniform mat4 mvp;
+
+out vec2 fragTexCoord;
+out vec4 fragColor;
+// Inner half size (xy), radius, line width; w is -1 for non-shape vertices
+// and -2 for distance field textures
+out vec4 shapeParams;
+
+void main()
+{
+    fragTexCoord = vertexTexCoord;
+    fragColor = vertexColor;
+    vec3 position = vertexPosition;
+    shapeParams = vec4(0.0, 0.0, 0.0, -1.0);
+    if (position.z <= -1048575.5)
+    {
+        if (vertexNormal.z < 0.0)
+        {
+            float packed = -position.z - 1048576.0;
+            float lineQuarters = floor(packed / 2048.0);
+            shapeParams = vec4(-vertexNormal.xy / vertexNormal.z,
+                               packed - lineQuarters * 2048.0,
+                               lineQuarters * 0.25);
+        }
+        else
+        {
+            // Distance field texture; x is the smoothing width
+            shapeParams = vec4(vertexNormal.x / vertexNormal.z, 0.0, 0.0, -2.0);
+        }
+        position.z = 0.0;
+    }
+    gl_Position = mvp * vec4(position, 1.0);
+}
+)";
+
+const char *shapeFragShader330 = R"(
+#version 330
+in vec2 fragTexCoord;
+in vec4 fragColor;
+in vec4 shapeParams;
+out vec4 finalColor;
+
+uniform sampler2D texture0;
+uniform vec4 colDiffuse;
+
+void main()
+{
+    if (shapeParams.w < 0.0)
+    {
+        vec4 texel = texture(texture0, fragTexCoord);
+        if (shapeParams.w < -1.5)
+        {
+            float alpha = smoothstep(0.5 - shapeParams.x, 0.5 + shapeParams.x,
+                                     texel.a);
+            finalColor = vec4(colDiffuse.rgb * fragColor.rgb,
+                              colDiffuse.a * fragColor.a * alpha);
+            return;
+        }
+        finalColor = texel * colDiffuse * fragColor;
+        return;
+    }
+    // Rounded box distance, one pixel wide anti-aliased edge
+    vec2 q = abs(fragTexCoord) - shapeParams.xy;
+    float d = length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - shapeParams.z;
+    float coverage = clamp(0.5 - d, 0.0, 1.0);
+    if (shapeParams.w > 0.0)
+    {
+        // Outline: the band of lineWidth just outside the box
+        coverage = clamp(0.5 - d + shapeParams.w, 0.0, 1.0) - coverage;
+    }
+    finalColor = colDiffuse * fragColor;
+    finalColor.a *= coverage;
+}
+)";
+
+const char *shapeVertShader100 = R"(
+#version 100
+attribute vec3 vertexPosition;
+attribute vec2 vertexTexCoord;
+attribute vec3 vertexNormal;
+attribute vec4 vertexColor;
+
+uniform mat4 mvp;
+
+varying vec2 fragTexCoord;
+varying vec4 fragColor;
+varying vec4 shapeParams;
+
+void main()
+{
+    fragTexCoord = vertexTexCoord;
+    fragColor = vertexColor;
+    vec3 position = vertexPosition;
+    shapeParams = vec4(0.0, 0.0, 0.0, -1.0);
+    if (position.z <= -1048575.5)
+    {
+        if (vertexNormal.z < 0.0)
+        {
+            float packed = -position.z - 1048576.0;
+            float lineQuarters = floor(packed / 2048.0);
+            shapeParams = vec4(-vertexNormal.xy / vertexNormal.z,
+                               packed - lineQuarters * 2048.0,
+                               lineQuarters * 0.25);
+        }
+        else
+        {
+            // Distance field texture; x is the smoothing width
+            shapeParams = vec4(vertexNormal.x / vertexNormal.z, 0.0, 0.0, -2.0);
+        }
+        position.z = 0.0;
+    }
+    gl_Position = mvp * vec4(position, 1.0);
+}
+)";
+
+const char *shapeFragShader100 = R"(
+#version 100
+#ifdef GL_FRAGMENT_PRECISION_HIGH
+precision highp float;
+#else
+precision mediump float;
+#endif
+
+varying vec2 fragTexCoord;
+varying vec4 fragColor;
+varying vec4 shapeParams;
+
+uniform sampler2D texture0;
+uniform vec4 colDiffuse;
+
+void main()
+{
+    if (shapeParams.w < 0.0)
+    {
+        vec4 texel = texture2D(texture0, fragTexCoord);
+        if (shapeParams.w < -1.5)
+        {
+            float alpha = smoothstep(0.5 - shapeParams.x, 0.5 + shapeParams.x,
+                                     texel.a);
+            gl_FragColor = vec4(colDiffuse.rgb * fragColor.rgb,
+                                colDiffuse.a * fragColor.a * alpha);
+            return;
+        }
+        gl_FragColor = texel * colDiffuse * fragColor;
+        return;
+    }
+    vec2 q = abs(fragTexCoord) - shapeParams.xy;
+    float d = length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - shapeParams.z;
+    float coverage = clamp(0.5 - d, 0.0, 1.0);
+    if (shapeParams.w > 0.0)
+    {
+        coverage = clamp(0.5 - d + shapeParams.w, 0.0, 1.0) - coverage;
+    }
+    gl_FragColor = colDiffuse * fragColor;
+    gl_FragColor.a *= coverage;
+}
+)";
+
+// Binds the shape shader, loading it on first use. Returns false if it
+// could not be compiled, in which case shapes are tessellated as before.
+bool BindShapeShader() {
+  if (!s_shapeShaderLoaded) {
+    s_shapeShader = LoadShaderFromMemory(shapeVertShader330, shapeFragShader330);
+    if (s_shapeShader.id == rlGetShaderIdDefault()) {
+      s_shapeShader =
+          LoadShaderFromMemory(shapeVertShader100, shapeFragShader100);
+    }
+    s_shapeShaderLoaded = true;
+  }
+  if (s_shapeShader.id == rlGetShaderIdDefault())
+    return false;
+  // No-op (and no batch flush) while the shader is already bound
+  BeginShaderMode(s_shapeShader);
+  s_shapeShaderBound = true;
+  return true;
+}
+
+// Outside a shape batch the shader is only held for the one draw, so the
+// host's drawing after it is not routed through it.
+void ReleaseShapeShader() {
+  if (s_shapeShaderBound && !s_shapeBatchOpen) {
+    EndShaderMode();
+    s_shapeShaderBound = false;
+  }
+}
+
+float RoundnessFor(Rectangle bounds, float cornerRadius) {
   // Raylib expects 1.0 for full rounding (radius = minDim/2).
   // So we need to normalize cornerRadius against minDim/2.
+  float minDim = std::min(bounds.width, bounds.height);
   float roundness = (minDim > 0) ? (2.0f * cornerRadius) / minDim : 0.0f;
-  roundness = std::clamp(roundness, 0.0f, 1.0f);
-  DrawRectangleRounded(bounds, roundness, 16,
+  return std::clamp(roundness, 0.0f, 1.0f);
+}
+
+// One quad covering the shape plus its outline and anti-aliasing margin.
+// lineWidth 0 fills; otherwise a band of lineWidth is drawn outside bounds,
+// matching DrawRectangleRoundedLinesEx.
+bool DrawShapeQuad(Rectangle bounds, float cornerRadius, float lineWidth,
+                   Color color) {
+  if (!s_sdfShapes || bounds.width <= 0.0f || bounds.height <= 0.0f)
+    return false;
+  if (!BindShapeShader())
+    return false;
+
+  float halfWidth = bounds.width * 0.5f;
+  float halfHeight = bounds.height * 0.5f;
+  float radius = std::clamp(cornerRadius, 0.0f,
+                            std::min({halfWidth, halfHeight, kShapeMaxRadius}));
+  float lineQuarters =
+      std::round(std::clamp(lineWidth, 0.0f, kShapeMaxLineWidth) * 4.0f);
+  float depth = -(kShapeDepthBase + lineQuarters * 2048.0f + radius);
+
+  float pad = lineQuarters * 0.25f + 1.0f;
+  float left = -halfWidth - pad;
+  float right = halfWidth + pad;
+  float top = -halfHeight - pad;
+  float bottom = halfHeight + pad;
+  float cx = bounds.x + halfWidth;
+  float cy = bounds.y + halfHeight;
+
+  rlSetTexture(GetShapesTexture().id);
+  rlBegin(RL_QUADS);
+  rlNormal3f(halfWidth - radius, halfHeight - radius, -1.0f);
+  rlColor4ub(color.r, color.g, color.b, color.a);
+  rlTexCoord2f(left, top);
+  rlVertex3f(cx + left, cy + top, depth);
+  rlTexCoord2f(left, bottom);
+  rlVertex3f(cx + left, cy + bottom, depth);
+  rlTexCoord2f(right, bottom);
+  rlVertex3f(cx + right, cy + bottom, depth);
+  rlTexCoord2f(right, top);
+  rlVertex3f(cx + right, cy + top, depth);
+  // Later batch vertices must not inherit the shape normal
+  rlNormal3f(0.0f, 0.0f, 1.0f);
+  rlEnd();
+  rlSetTexture(0);
+  ReleaseShapeShader();
+  return true;
+}
+
+// Elevation shadows: a blurred rounded rectangle per (elevation, radius),
+// rasterized once on the CPU and packed into one atlas, so each shadow is a
+// nine-patch draw that batches with other shadows.
+//
+// The atlas is cut into square cells of three size classes (an entry is at
+// most 2 * (22 + 64) + 1 = 173px), opened row by row on demand. Once it is
+// full, the least recently used cell large enough for the new entry is
+// evicted, so a screen with many radii only re-blurs the entries it stopped
+// using instead of the whole atlas.
+constexpr int kShadowAtlasSize = 1024;
+constexpr int kShadowMaxRadius = 64;
+constexpr int kShadowCellSizes[] = {48, 96, 176};
+
+struct ShadowEntry {
+  NPatchInfo patch;
+  float pad; // Blur extent around the shape, in pixels
+  int cell;  // Index into s_shadowCells
+};
+
+struct ShadowCell {
+  int x;
+  int y;
+  int size;
+  uint32_t key;      // Entry held by the cell
+  uint64_t lastUsed; // s_shadowClock at the last lookup
+};
+
+struct ShadowRow {
+  int y;
+  int cellSize;
+  int nextX;
+};
+
+Texture2D s_shadowAtlas = {0};
+std::unordered_map<uint32_t, ShadowEntry> s_shadowEntries;
+std::vector<ShadowCell> s_shadowCells;
+std::vector<ShadowRow> s_shadowRows;
+int s_shadowNextRowY = 0;
+uint64_t s_shadowClock = 0;
+
+// One separable box blur pass in each direction; zero outside the image
+void BoxBlur(std::vector<float> &values, int size, int radius) {
+  std::vector<float> line(size);
+  float scale = 1.0f / (2 * radius + 1);
+  for (int pass = 0; pass < 2; ++pass) {
+    for (int row = 0; row < size; ++row) {
+      auto at = [&](int i) -> float & {
+        return pass == 0 ? values[row * size + i] : values[i * size + row];
+      };
+      float sum = 0.0f;
+      for (int i = 0; i <= radius && i < size; ++i)
+        sum += at(i);
+      for (int i = 0; i < size; ++i) {
+        line[i] = sum * scale;
+        if (i + radius + 1 < size)
+          sum += at(i + radius + 1);
+        if (i - radius >= 0)
+          sum -= at(i - radius);
+      }
+      for (int i = 0; i < size; ++i)
+        at(i) = line[i];
+    }
+  }
+}
+
+// Square image of a (2 * radius + 1) rounded square, blurred into the
+// surrounding pad; the center row and column are the nine-patch stretch
+std::vector<Color> RasterizeShadow(int radius, int blurRadius, int pad) {
+  int size = 2 * (pad + radius) + 1;
+  float center = size * 0.5f;
+  float inner = 0.5f; // Half size minus corner radius
+  std::vector<float> coverage(size * size);
+  for (int y = 0; y < size; ++y) {
+    for (int x = 0; x < size; ++x) {
+      float qx = std::fabs(x + 0.5f - center) - inner;
+      float qy = std::fabs(y + 0.5f - center) - inner;
+      float outside = std::hypot(std::max(qx, 0.0f), std::max(qy, 0.0f));
+      float d = outside + std::min(std::max(qx, qy), 0.0f) - radius;
+      coverage[y * size + x] = std::clamp(0.5f - d, 0.0f, 1.0f);
+    }
+  }
+  // Three box passes approximate a Gaussian
+  for (int i = 0; i < 3; ++i) {
+    BoxBlur(coverage, size, blurRadius);
+  }
+  std::vector<Color> pixels(size * size);
+  for (int i = 0; i < size * size; ++i) {
+    unsigned char alpha =
+        static_cast<unsigned char>(std::lround(coverage[i] * 255.0f));
+    pixels[i] = {255, 255, 255, alpha};
+  }
+  return pixels;
+}
+
+// Returns a cell that fits size: a new one from an open row or a new row
+// (1px gutters), else the least recently used cell at least that large,
+// whose entry is evicted. -1 if nothing fits.
+int AllocateShadowCell(int size) {
+  int cellSize = kShadowCellSizes[std::size(kShadowCellSizes) - 1];
+  for (int candidate : kShadowCellSizes) {
+    if (size <= candidate) {
+      cellSize = candidate;
+      break;
+    }
+  }
+
+  auto openCell = [&](ShadowRow &row) {
+    s_shadowCells.push_back({row.nextX, row.y, row.cellSize, 0, 0});
+    row.nextX += row.cellSize + 1;
+    return static_cast<int>(s_shadowCells.size()) - 1;
+  };
+  for (ShadowRow &row : s_shadowRows) {
+    if (row.cellSize == cellSize &&
+        row.nextX + cellSize <= kShadowAtlasSize)
+      return openCell(row);
+  }
+  if (s_shadowNextRowY + cellSize <= kShadowAtlasSize) {
+    s_shadowRows.push_back({s_shadowNextRowY, cellSize, 0});
+    s_shadowNextRowY += cellSize + 1;
+    return openCell(s_shadowRows.back());
+  }
+
+  int victim = -1;
+  for (int i = 0; i < (int)s_shadowCells.size(); ++i) {
+    const ShadowCell &candidate = s_shadowCells[i];
+    if (candidate.size >= size &&
+        (victim < 0 || candidate.lastUsed < s_shadowCells[victim].lastUsed))
+      victim = i;
+  }
+  if (victim < 0)
+    return -1;
+  s_shadowEntries.erase(s_shadowCells[victim].key);
+  // Shadows already batched this frame may still sample the old pixels
+  rlDrawRenderBatchActive();
+  return victim;
+}
+
+const ShadowEntry *GetShadowEntry(int elevation, int radius) {
+  uint32_t key = (static_cast<uint32_t>(elevation) << 16) |
+                 static_cast<uint32_t>(radius);
+  auto it = s_shadowEntries.find(key);
+  if (it != s_shadowEntries.end()) {
+    s_shadowCells[it->second.cell].lastUsed = ++s_shadowClock;
+    return &it->second;
+  }
+
+  if (s_shadowAtlas.id == 0) {
+    Image blank = GenImageColor(kShadowAtlasSize, kShadowAtlasSize, BLANK);
+    s_shadowAtlas = LoadTextureFromImage(blank);
+    UnloadImage(blank);
+    if (s_shadowAtlas.id == 0)
+      return nullptr;
+    SetTextureFilter(s_shadowAtlas, TEXTURE_FILTER_BILINEAR);
+  }
+
+  // Box radius r gives a variance of r(r + 1) per pass, close to sigma^2
+  float sigma = Theme::GetElevationShadow(elevation) * 0.5f + 1.0f;
+  int blurRadius = std::max(1, static_cast<int>(std::lround(sigma - 0.5f)));
+  int pad = 3 * blurRadius + 1;
+  int size = 2 * (pad + radius) + 1;
+
+  int cell = AllocateShadowCell(size);
+  if (cell < 0)
+    return nullptr;
+  ShadowCell &slot = s_shadowCells[cell];
+  slot.key = key;
+  slot.lastUsed = ++s_shadowClock;
+
+  Rectangle source = {(float)slot.x, (float)slot.y, (float)size, (float)size};
+  std::vector<Color> pixels = RasterizeShadow(radius, blurRadius, pad);
+  UpdateTextureRec(s_shadowAtlas, source, pixels.data());
+
+  int border = pad + radius;
+  ShadowEntry entry;
+  entry.patch = {source, border, border, border, border, NPATCH_NINE_PATCH};
+  entry.pad = static_cast<float>(pad);
+  entry.cell = cell;
+  return &s_shadowEntries.emplace(key, entry).first->second;
+}
+
+} // namespace
+
+void Renderer::DrawRoundedRectangle(Rectangle bounds, float cornerRadius,
+                                    Color color) {
+  if (DrawShapeQuad(bounds, cornerRadius, 0.0f, color))
+    return;
+  DrawRectangleRounded(bounds, RoundnessFor(bounds, cornerRadius), 16,
                        color); // Increased segments for smoothness
 }
 
 void Renderer::DrawRoundedRectangleEx(Rectangle bounds, float cornerRadius,
                                       Color color, float lineWidth) {
-  float minDim = std::min(bounds.width, bounds.height);
-  float roundness = (minDim > 0) ? (2.0f * cornerRadius) / minDim : 0.0f;
-  roundness = std::clamp(roundness, 0.0f, 1.0f);
+  if (DrawShapeQuad(bounds, cornerRadius, std::max(lineWidth, 0.25f), color))
+    return;
+  float roundness = RoundnessFor(bounds, cornerRadius);
 #ifdef PLATFORM_ANDROID
   DrawRectangleRoundedLinesEx(bounds, roundness, 16, lineWidth, color);
 #else
@@ -28,6 +618,81 @@ void Renderer::DrawRoundedRectangleEx(Rectangle bounds, float cornerRadius,
 #endif
 }
 
+void Renderer::BeginShapeBatch() { s_shapeBatchOpen = true; }
+
+void Renderer::EndShapeBatch() {
+  s_shapeBatchOpen = false;
+  SuspendShapeBatch();
+}
+
+void Renderer::SuspendShapeBatch() {
+  if (s_shapeShaderBound) {
+    EndShaderMode();
+    s_shapeShaderBound = false;
+  }
+}
+
+bool Renderer::DrawDistanceField(Texture2D texture, Rectangle source,
+                                 Rectangle dest, float smoothing,
+                                 Color color) {
+  if (texture.id == 0 || texture.width <= 0 || texture.height <= 0)
+    return false;
+  if (!BindShapeShader())
+    return false;
+
+  float u0 = source.x / texture.width;
+  float v0 = source.y / texture.height;
+  float u1 = (source.x + source.width) / texture.width;
+  float v1 = (source.y + source.height) / texture.height;
+  float depth = -kShapeDepthBase;
+
+  rlSetTexture(texture.id);
+  rlBegin(RL_QUADS);
+  rlNormal3f(smoothing, 0.0f, 1.0f);
+  rlColor4ub(color.r, color.g, color.b, color.a);
+  rlTexCoord2f(u0, v0);
+  rlVertex3f(dest.x, dest.y, depth);
+  rlTexCoord2f(u0, v1);
+  rlVertex3f(dest.x, dest.y + dest.height, depth);
+  rlTexCoord2f(u1, v1);
+  rlVertex3f(dest.x + dest.width, dest.y + dest.height, depth);
+  rlTexCoord2f(u1, v0);
+  rlVertex3f(dest.x + dest.width, dest.y, depth);
+  rlNormal3f(0.0f, 0.0f, 1.0f);
+  rlEnd();
+  rlSetTexture(0);
+  ReleaseShapeShader();
+  return true;
+}
+
+void Renderer::SetSdfShapes(bool enabled) {
+  if (!enabled)
+    EndShapeBatch();
+  s_sdfShapes = enabled;
+}
+
+bool Renderer::IsSdfShapes() { return s_sdfShapes; }
+
+void Renderer::Shutdown() {
+  EndShapeBatch();
+  if (s_shapeShaderLoaded) {
+    if (s_shapeShader.id != rlGetShaderIdDefault())
+      UnloadShader(s_shapeShader);
+    s_shapeShader = {0};
+    s_shapeShaderLoaded = false;
+  }
+  if (s_shadowAtlas.id != 0) {
+    UnloadTexture(s_shadowAtlas);
+    s_shadowAtlas = {0};
+  }
+  s_shadowEntries.clear();
+  s_shadowCells.clear();
+  s_shadowRows.clear();
+  s_shadowNextRowY = 0;
+  s_lastPrefixSlot = -1; // Nothing may hold text advances past shutdown
+  ClearTextMeasureCache();
+}
+
 void Renderer::DrawElevatedRectangle(Rectangle bounds, float cornerRadius,
                                      int elevation, Color color) {
   if (elevation > 0) {
@@ -37,31 +702,23 @@ void Renderer::DrawElevatedRectangle(Rectangle bounds, float cornerRadius,
 }
 
 void Renderer::DrawShadow(Rectangle bounds, float cornerRadius, int elevation) {
-  Color shadowColor = Theme::GetElevationColor(elevation);
-  float shadowOffset = Theme::GetElevationShadow(elevation);
-
-  // User request: "shadownshould be more visible"
-  // The current implementation is a simple offset rectangle which looks flat.
-  // To make it more visible/realistic without shaders, we can:
-  // 1. Draw multiple layers with decreasing opacity (fake blur)
-  // 2. Increase offset or opacity (currently controlled by
-  // Theme::GetElevationColor/Shadow) Let's try drawing a few layers for a
-  // softer look, or just darker/bigger offset.
-
-  // Simple improvement: multiple passes
-  int layers = 3;
-  for (int i = 0; i < layers; i++) {
-    float scale = 1.0f + (float)(i + 1) * 0.02f;
-    float offset = shadowOffset * (float)(i + 1) / layers;
-    // Just simple offset for now to avoid complex scaling math on rect
+  if (bounds.width <= 0.0f || bounds.height <= 0.0f)
+    return;
+  float maxRadius = std::min(bounds.width, bounds.height) * 0.5f;
+  int radius = static_cast<int>(std::lround(
+      std::clamp(cornerRadius, 0.0f, std::min(maxRadius, (float)kShadowMaxRadius))));
+  const ShadowEntry *entry = GetShadowEntry(elevation, radius);
+  if (!entry)
+    return;
 
-    Rectangle shadowBounds = {bounds.x + offset, bounds.y + offset,
-                              bounds.width, bounds.height};
-
-    Color layerColor =
-        ColorAlpha(shadowColor, 0.3f / layers); // Distribute opacity
-    DrawRoundedRectangle(shadowBounds, cornerRadius, layerColor);
-  }
+  // Key light from above: the shadow drops by half the elevation offset
+  float drop = Theme::GetElevationShadow(elevation) * 0.5f;
+  Rectangle dest = {bounds.x - entry->pad, bounds.y - entry->pad + drop,
+                    bounds.width + 2.0f * entry->pad,
+                    bounds.height + 2.0f * entry->pad};
+  Color tint = ColorAlpha(Theme::GetElevationColor(elevation), 0.3f);
+  DrawTextureNPatch(s_shadowAtlas, entry->patch, dest, {0.0f, 0.0f}, 0.0f,
+                    tint);
 }
 
 void Renderer::DrawStateLayer(Rectangle bounds, float cornerRadius,
@@ -74,6 +731,7 @@ void Renderer::DrawStateLayer(Rectangle bounds, float cornerRadius,
 
 void Renderer::DrawText(const char *text, Vector2 position, float fontSize,
                         Color color, FontWeight weight) {
+  PrepareGlyphs(text, fontSize, weight);
   Font font = Theme::GetFont(fontSize, weight);
   DrawTextEx(font, text, position, fontSize, 0, color);
 }
@@ -81,8 +739,8 @@ void Renderer::DrawText(const char *text, Vector2 position, float fontSize,
 void Renderer::DrawTextCentered(const char *text, Rectangle bounds,
                                 float fontSize, Color color,
                                 FontWeight weight) {
+  Vector2 textSize = MeasureText(text, fontSize, weight);
   Font font = Theme::GetFont(fontSize, weight);
-  Vector2 textSize = MeasureTextEx(font, text, fontSize, 0);
 
   Vector2 position = {bounds.x + (bounds.width - textSize.x) / 2.0f,
                       bounds.y + (bounds.height - textSize.y) / 2.0f};
@@ -92,8 +750,154 @@ void Renderer::DrawTextCentered(const char *text, Rectangle bounds,
 
 Vector2 Renderer::MeasureText(const char *text, float fontSize,
                               FontWeight weight) {
-  Font font = Theme::GetFont(fontSize, weight);
-  return MeasureTextEx(font, text, fontSize, 0);
+  if (!text || text[0] == '\0')
+    return {0, 0};
+
+  SyncGlyphGeneration();
+  uint64_t key = MeasureKey(text, fontSize, weight);
+  auto cached = s_measureCache.find(key);
+  if (cached != s_measureCache.end() &&
+      cached->second.source.Matches(text, fontSize, weight)) {
+    s_measureStats.hits++;
+    return cached->second.size;
+  }
+  s_measureStats.misses++;
+  PrepareGlyphs(text, fontSize, weight);
+
+  FontAdvances *advances = GetFontAdvances(fontSize, weight);
+  if (!advances) {
+    return MeasureTextEx(Theme::GetFont(fontSize, weight), text, fontSize, 0);
+  }
+
+  Vector2 size;
+  if (std::strchr(text, '\n')) {
+    // Multi-line height depends on raylib's line spacing; let it measure
+    size = MeasureTextEx(advances->font, text, fontSize, 0);
+  } else {
+    float width = 0.0f;
+    for (int i = 0; text[i] != '\0';) {
+      int byteCount = 0;
+      int codepoint = GetCodepointNext(&text[i], &byteCount);
+      width += GlyphAdvance(*advances, codepoint);
+      i += byteCount;
+    }
+    size = {width * fontSize / (float)advances->font.baseSize, fontSize};
+  }
+
+  if (s_measureCache.size() >= kMaxMeasureEntries) {
+    s_measureCache.clear();
+  }
+  // Replaces a colliding entry
+  MeasureEntry &entry = s_measureCache[key];
+  entry.source.Assign(text, fontSize, weight);
+  entry.size = size;
+  return size;
+}
+
+TextAdvances Renderer::GetTextAdvances(const char *text, float fontSize,
+                                       FontWeight weight) {
+  if (!text)
+    text = "";
+
+  SyncGlyphGeneration();
+  uint64_t key = MeasureKey(text, fontSize, weight);
+  PrefixSlot *slot = nullptr;
+  for (PrefixSlot &candidate : s_prefixSlots) {
+    if (candidate.key == key && !candidate.x.empty() &&
+        candidate.source.Matches(text, fontSize, weight)) {
+      slot = &candidate;
+      break;
+    }
+  }
+
+  if (slot) {
+    s_measureStats.hits++;
+  } else {
+    s_measureStats.misses++;
+    PrepareGlyphs(text, fontSize, weight);
+    slot = &s_prefixSlots[s_nextPrefixSlot];
+    s_nextPrefixSlot = (s_nextPrefixSlot + 1) % kPrefixSlots;
+    slot->key = key;
+    slot->source.Assign(text, fontSize, weight);
+    slot->x.clear();
+    slot->byteOffsets.clear();
+
+    FontAdvances *advances = GetFontAdvances(fontSize, weight);
+    float scale =
+        advances ? fontSize / (float)advances->font.baseSize : 0.0f;
+    float width = 0.0f;
+    int i = 0;
+    while (text[i] != '\0') {
+      slot->x.push_back(width * scale);
+      slot->byteOffsets.push_back(i);
+      int byteCount = 0;
+      int codepoint = GetCodepointNext(&text[i], &byteCount);
+      if (advances && codepoint != '\n') {
+        width += GlyphAdvance(*advances, codepoint);
+      }
+      i += byteCount;
+    }
+    slot->x.push_back(width * scale);
+    slot->byteOffsets.push_back(i);
+  }
+
+  s_lastPrefixSlot = (int)(slot - s_prefixSlots);
+  TextAdvances result;
+  result.x = slot->x.data();
+  result.byteOffsets = slot->byteOffsets.data();
+  result.count = (int)slot->x.size() - 1;
+  return result;
+}
+
+float TextAdvances::XAtByte(int byteOffset) const {
+  if (!x)
+    return 0.0f;
+  // Last boundary at or before byteOffset
+  const int *end = byteOffsets + count + 1;
+  int index = (int)(std::upper_bound(byteOffsets, end, byteOffset) -
+                    byteOffsets) - 1;
+  return x[std::max(index, 0)];
+}
+
+int TextAdvances::ByteAtX(float targetX) const {
+  if (!x)
+    return 0;
+  const float *end = x + count + 1;
+  int index = (int)(std::lower_bound(x, end, targetX) - x);
+  if (index > count)
+    return byteOffsets[count];
+  if (index > 0 && targetX - x[index - 1] <= x[index] - targetX)
+    index--;
+  return byteOffsets[index];
+}
+
+int TextAdvances::FitCount(float maxWidth) const {
+  if (!x)
+    return 0;
+  const float *end = x + count + 1;
+  int fit = (int)(std::upper_bound(x, end, maxWidth) - x) - 1;
+  return std::max(fit, 0);
+}
+
+TextMeasureStats Renderer::GetTextMeasureStats() {
+  TextMeasureStats stats = s_measureStats;
+  stats.entries = s_measureCache.size();
+  stats.fonts = s_fontAdvances.size();
+  return stats;
+}
+
+void Renderer::ClearTextMeasureCache() {
+  s_measureCache.clear();
+  s_fontAdvances.clear();
+  for (int i = 0; i < kPrefixSlots; ++i) {
+    PrefixSlot &slot = s_prefixSlots[i];
+    // Never a hit again, but the arrays stay readable until reused
+    slot.key = 0;
+    if (i == s_lastPrefixSlot)
+      continue;
+    slot.x.clear();
+    slot.byteOffsets.clear();
+  }
 }
 
 } // namespace raym3
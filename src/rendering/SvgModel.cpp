@@ -1,5 +1,7 @@
 #include "raym3/rendering/SvgModel.h"
+#include "rendering/IconPack.h"
 #include <cstdio>
+#include <cstdlib>
 
 #define NANOSVG_IMPLEMENTATION
 #include "external/nanosvg.h"
@@ -25,6 +27,80 @@ bool SvgModel::LoadFromString(const char *data) {
   return image != nullptr;
 }
 
+bool SvgModel::LoadFromPack(const IconPack &pack, const IconPackEntry &entry) {
+  Unload();
+
+  // Allocate with malloc/calloc so nsvgDelete can free the result
+  image = (NSVGimage *)calloc(1, sizeof(NSVGimage));
+  if (!image)
+    return false;
+  image->width = entry.width;
+  image->height = entry.height;
+
+  NSVGshape **shapeTail = &image->shapes;
+  for (uint32_t s = 0; s < entry.shapeCount; ++s) {
+    const IconPackShape &packed = pack.shapes[entry.firstShape + s];
+    NSVGshape *shape = (NSVGshape *)calloc(1, sizeof(NSVGshape));
+    if (!shape) {
+      Unload();
+      return false;
+    }
+    shape->fill.type = (signed char)packed.fillType;
+    shape->fill.color = packed.fillColor;
+    shape->stroke.type = (signed char)packed.strokeType;
+    shape->stroke.color = packed.strokeColor;
+    shape->opacity = packed.opacity;
+    shape->strokeWidth = packed.strokeWidth;
+    shape->miterLimit = packed.miterLimit;
+    shape->fillRule = (char)packed.fillRule;
+    shape->strokeLineJoin = (char)packed.strokeLineJoin;
+    shape->strokeLineCap = (char)packed.strokeLineCap;
+    shape->paintOrder = packed.paintOrder;
+    shape->flags = NSVG_FLAGS_VISIBLE;
+    shape->bounds[0] = shape->bounds[1] = 1e30f;
+    shape->bounds[2] = shape->bounds[3] = -1e30f;
+    *shapeTail = shape;
+    shapeTail = &shape->next;
+
+    NSVGpath **pathTail = &shape->paths;
+    for (uint32_t p = 0; p < packed.pathCount; ++p) {
+      const IconPackPath &packedPath = pack.paths[packed.firstPath + p];
+      NSVGpath *path = (NSVGpath *)calloc(1, sizeof(NSVGpath));
+      float *pts = (float *)malloc(sizeof(float) * 2 * packedPath.pointCount);
+      if (!path || !pts) {
+        free(path);
+        free(pts);
+        Unload();
+        return false;
+      }
+      memcpy(pts, pack.points + packedPath.firstPoint * 2,
+             sizeof(float) * 2 * packedPath.pointCount);
+      path->pts = pts;
+      path->npts = (int)packedPath.pointCount;
+      path->closed = (char)packedPath.closed;
+
+      // Control-point bounds are sufficient for rasterization
+      path->bounds[0] = path->bounds[1] = 1e30f;
+      path->bounds[2] = path->bounds[3] = -1e30f;
+      for (int i = 0; i < path->npts; ++i) {
+        float x = pts[i * 2], y = pts[i * 2 + 1];
+        path->bounds[0] = fminf(path->bounds[0], x);
+        path->bounds[1] = fminf(path->bounds[1], y);
+        path->bounds[2] = fmaxf(path->bounds[2], x);
+        path->bounds[3] = fmaxf(path->bounds[3], y);
+      }
+      for (int i = 0; i < 2; ++i) {
+        shape->bounds[i] = fminf(shape->bounds[i], path->bounds[i]);
+        shape->bounds[i + 2] = fmaxf(shape->bounds[i + 2], path->bounds[i + 2]);
+      }
+
+      *pathTail = path;
+      pathTail = &path->next;
+    }
+  }
+  return true;
+}
+
 void SvgModel::Unload() {
   if (image) {
     nsvgDelete(image);
@@ -1,12 +1,27 @@
 #include "raym3/rendering/SvgRenderer.h"
+#include "raym3/rendering/Renderer.h"
 #include "raym3/rendering/SvgModel.h"
 #include "raym3/config.h"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
 #include <filesystem>
+#include <rlgl.h>
 #include <iostream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
+#include <cmath>
 #include <cstring>
 
-#if RAYM3_EMBED_RESOURCES
+#if RAYM3_EMBED_ICON_PACK
+#include "EmbeddedIcons.h"
+#elif RAYM3_EMBED_RESOURCES
 #include "EmbeddedResources.h"
 #endif
 
@@ -16,9 +31,150 @@
 namespace raym3 {
 
 std::string SvgRenderer::basePath = "";
-std::unordered_map<std::string, Texture2D> SvgRenderer::textureCache;
 bool SvgRenderer::autoDetected = false;
 
+// Icon atlas. Pages are square RGBA textures packed in horizontal shelves;
+// each icon keeps a transparent border so bilinear sampling never bleeds
+// into its neighbours.
+static constexpr int kAtlasPageSize = 1024;
+static constexpr int kAtlasPadding = 1;
+
+struct AtlasShelf {
+  int y = 0;
+  int height = 0;
+  int x = 0; // Next free column
+};
+
+struct AtlasPage {
+  Texture2D texture = {0};
+  std::vector<AtlasShelf> shelves;
+  int nextShelfY = 0;
+  int usedArea = 0;
+  int iconCount = 0;
+  unsigned long long lastUsed = 0;
+};
+
+// A resident icon: a rect on an atlas page, or its own texture (icons too
+// large for a page, and SDF fields). Standalone textures are kept in an
+// LRU list and evicted when the cache exceeds its byte budget.
+struct IconCacheEntry {
+  int page = -1;                   // -1 for a standalone texture
+  Rectangle source = {0, 0, 0, 0}; // Pixel rect inside the page
+  Texture2D texture = {0};         // Standalone only; id 0 = failed to load
+  std::list<uint64_t>::iterator lru;
+};
+
+// Icon names are interned to small integers so the per-draw cache key is a
+// single 64-bit value; lookups take a string_view and never allocate
+struct IconNameHash {
+  using is_transparent = void;
+  size_t operator()(std::string_view name) const {
+    return std::hash<std::string_view>{}(name);
+  }
+};
+
+// Parsed SVGs keyed by "variation/name" (nullptr marks a missing icon), and
+// a rasterizer and pixel buffer reused across rasterizations on the main
+// thread. s_svgMutex guards s_parsedSvgs and the base path, which icon
+// workers also read.
+static std::unordered_map<std::string, std::shared_ptr<SvgModel>> s_parsedSvgs;
+static std::mutex s_svgMutex;
+static NSVGrasterizer *s_rasterizer = nullptr;
+static std::vector<unsigned char> s_scratchPixels;
+
+static std::vector<AtlasPage> s_atlasPages;
+static std::unordered_map<uint64_t, IconCacheEntry> s_iconEntries;
+static std::list<uint64_t> s_textureLru; // Most recently used first
+static size_t s_textureBytes = 0;        // Bytes held by standalone textures
+static std::unordered_map<std::string, uint32_t, IconNameHash, std::equal_to<>>
+    s_iconIds;
+static IconCacheLimits s_cacheLimits;
+static uint64_t s_cacheHits = 0;
+static uint64_t s_cacheMisses = 0;
+static uint64_t s_cacheEvictions = 0;
+static unsigned long long s_atlasUseCounter = 0;
+
+// Async icon loading. Workers parse and rasterize into CPU buffers; the main
+// thread uploads finished icons in ProcessPendingUploads.
+struct IconJob {
+  uint64_t key = 0;
+  std::string name;
+  IconVariation variation = IconVariation::Filled;
+  int width = 0;
+  int height = 0;
+  int padding = 0;
+};
+
+struct IconJobResult {
+  uint64_t key = 0;
+  Image image = {0}; // data == nullptr if the icon could not be loaded
+  int width = 0;
+  int height = 0;
+  int padding = 0;
+};
+
+static IconLoaderOptions s_loaderOptions;
+static std::vector<std::thread> s_iconWorkers;
+static std::deque<IconJob> s_iconJobs;
+static std::vector<IconJobResult> s_finishedIcons;
+static std::mutex s_iconJobMutex;
+static std::condition_variable s_iconJobCondition;
+static bool s_stopIconWorkers = false;
+static std::unordered_set<uint64_t> s_pendingIcons; // Main thread only
+
+// SDF icons: one distance field per (variation, name) rasterized at a
+// reference size, drawn at any size through a smoothstep shader
+static constexpr int kSdfReferenceSize = 64;
+static constexpr int kSdfSpread = 8; // Distance range in reference pixels
+
+static Shader s_sdfShader = {0};
+static int s_sdfShaderLocSmoothing = -1;
+static bool s_sdfShaderLoaded = false;
+static bool s_sdfMode = false;
+
+static const char *sdfFragShader330 = R"(
+#version 330
+in vec2 fragTexCoord;
+in vec4 fragColor;
+out vec4 finalColor;
+
+uniform sampler2D texture0;
+uniform vec4 colDiffuse;
+
+// Half the width of the anti-aliased edge in distance-field units
+uniform float smoothing;
+
+void main()
+{
+    // Alpha stores 0.5 on the outline, > 0.5 inside the shape
+    float dist = texture(texture0, fragTexCoord).a;
+    float alpha = smoothstep(0.5 - smoothing, 0.5 + smoothing, dist);
+    finalColor = vec4(colDiffuse.rgb * fragColor.rgb,
+                      colDiffuse.a * fragColor.a * alpha);
+}
+)";
+
+static const char *sdfFragShader100 = R"(
+#version 100
+precision mediump float;
+
+varying vec2 fragTexCoord;
+varying vec4 fragColor;
+
+uniform sampler2D texture0;
+uniform vec4 colDiffuse;
+
+uniform float smoothing;
+
+void main()
+{
+    float dist = texture2D(texture0, fragTexCoord).a;
+    float alpha = smoothstep(0.5 - smoothing, 0.5 + smoothing, dist);
+    gl_FragColor = vec4(colDiffuse.rgb * fragColor.rgb,
+                        colDiffuse.a * fragColor.a * alpha);
+}
+)";
+
 static std::string DetectIconPath() {
   std::vector<std::string> searchPaths = {
     std::string(RAYM3_RESOURCE_DIR) + "/icons",
@@ -45,12 +201,16 @@ static std::string DetectIconPath() {
 }
 
 void SvgRenderer::Initialize(const char *path) {
+  // Icon workers read basePath under the same lock
+  std::lock_guard<std::mutex> lock(s_svgMutex);
   if (path && strlen(path) > 0) {
     basePath = path;
     if (!basePath.empty() && basePath.back() != '/') {
       basePath += '/';
     }
     autoDetected = false;
+    // Forget icons resolved against the old path
+    s_parsedSvgs.clear();
   } else if (!autoDetected) {
     basePath = DetectIconPath();
     autoDetected = true;
@@ -58,10 +218,42 @@ void SvgRenderer::Initialize(const char *path) {
 }
 
 void SvgRenderer::Shutdown() {
-  for (auto &pair : textureCache) {
-    UnloadTexture(pair.second);
+  StopIconWorkers();
+
+  for (auto &pair : s_iconEntries) {
+    if (pair.second.texture.id != 0) {
+      UnloadTexture(pair.second.texture);
+    }
+  }
+  s_iconEntries.clear();
+  s_textureLru.clear();
+  s_textureBytes = 0;
+  s_iconIds.clear();
+  s_cacheHits = 0;
+  s_cacheMisses = 0;
+  s_cacheEvictions = 0;
+
+  for (AtlasPage &page : s_atlasPages) {
+    UnloadTexture(page.texture);
+  }
+  s_atlasPages.clear();
+  s_atlasUseCounter = 0;
+
+  {
+    std::lock_guard<std::mutex> lock(s_svgMutex);
+    s_parsedSvgs.clear();
+  }
+  if (s_rasterizer) {
+    nsvgDeleteRasterizer(s_rasterizer);
+    s_rasterizer = nullptr;
+  }
+  s_scratchPixels.clear();
+  s_scratchPixels.shrink_to_fit();
+
+  if (s_sdfShaderLoaded) {
+    UnloadShader(s_sdfShader);
+    s_sdfShaderLoaded = false;
   }
-  textureCache.clear();
 }
 
 const char *SvgRenderer::GetVariationFolder(IconVariation variation) {
@@ -81,106 +273,407 @@ const char *SvgRenderer::GetVariationFolder(IconVariation variation) {
   }
 }
 
-std::string SvgRenderer::GetCacheKey(const char *name, IconVariation variation,
-                                     int width, int height) {
-  return std::string(name) + "_" + GetVariationFolder(variation) + "_" +
-         std::to_string(width) + "x" + std::to_string(height);
-}
+uint64_t SvgRenderer::GetCacheKey(const char *name, IconVariation variation,
+                                  int width, int height, bool sdf) {
+  uint32_t iconId;
+  auto it = s_iconIds.find(std::string_view(name));
+  if (it != s_iconIds.end()) {
+    iconId = it->second;
+  } else {
+    iconId = (uint32_t)s_iconIds.size() + 1;
+    s_iconIds.emplace(name, iconId);
+  }
 
-Texture2D SvgRenderer::LoadSvgTexture(const char *name, IconVariation variation,
-                                      int width, int height) {
-  SvgModel model;
-  bool loaded = false;
+  // Layout: icon id (32) | variation (3) | sdf (1) | width (14) | height (14)
+  uint64_t w = (uint64_t)std::min(width, 0x3FFF);
+  uint64_t h = (uint64_t)std::min(height, 0x3FFF);
+  return ((uint64_t)iconId << 32) | ((uint64_t)((int)variation & 0x7) << 29) |
+         ((uint64_t)(sdf ? 1 : 0) << 28) | (w << 14) | h;
+}
 
-#if RAYM3_EMBED_RESOURCES
+std::shared_ptr<SvgModel> SvgRenderer::GetSvgModel(const char *name,
+                                                  IconVariation variation) {
   std::string folder = GetVariationFolder(variation);
   std::string iconKey = folder + "/" + name;
-  auto it = embedded_icons.find(iconKey);
-  if (it != embedded_icons.end()) {
-    loaded = model.LoadFromString(it->second.c_str());
-  }
-#endif
+  std::string iconDir;
 
-  if (!loaded) {
+  {
+    std::lock_guard<std::mutex> lock(s_svgMutex);
+    auto cached = s_parsedSvgs.find(iconKey);
+    if (cached != s_parsedSvgs.end()) {
+      return cached->second; // nullptr if the icon is known to be missing
+    }
     if (basePath.empty() && !autoDetected) {
       basePath = DetectIconPath();
       autoDetected = true;
     }
+    iconDir = basePath;
+  }
 
-    std::string folder = GetVariationFolder(variation);
-    std::string fullPath = basePath + folder + "/" + name + ".svg";
+  // Parse once (outside the lock so workers can parse in parallel); later
+  // sizes of the same icon only rasterize
+  std::shared_ptr<SvgModel> model = std::make_shared<SvgModel>();
+  bool loaded = false;
+
+#if RAYM3_EMBED_ICON_PACK
+  // Pre-parsed at build time: no XML parsing, just copy the paths out
+  if (const IconPackEntry *packed = FindPackedIcon(kEmbeddedIconPack, iconKey)) {
+    loaded = model->LoadFromPack(kEmbeddedIconPack, *packed);
+  }
+#elif RAYM3_EMBED_RESOURCES
+  auto it = embedded_icons.find(iconKey);
+  if (it != embedded_icons.end()) {
+    // nsvgParse writes into its input, so parse a private copy
+    std::string source = it->second;
+    loaded = model->LoadFromString(source.c_str());
+  }
+#endif
+
+  if (!loaded) {
+    std::string fullPath = iconDir + folder + "/" + name + ".svg";
 
     if (!std::filesystem::exists(fullPath)) {
       std::cerr << "Icon not found: " << fullPath << std::endl;
-      return {0};
-    }
-
-    loaded = model.LoadFromFile(fullPath.c_str());
-    if (!loaded) {
-      std::cerr << "Failed to load SVG: " << fullPath << std::endl;
-      return {0};
+    } else {
+      loaded = model->LoadFromFile(fullPath.c_str());
+      if (!loaded) {
+        std::cerr << "Failed to load SVG: " << fullPath << std::endl;
+      }
     }
   }
 
-  // Rasterize using nanosvgrast
-  NSVGrasterizer *rast = nsvgCreateRasterizer();
-  if (rast == nullptr) {
-    return {0};
+  if (!loaded) {
+    model.reset();
   }
 
-  // Allocate pixel buffer (RGBA)
-  int stride = width * 4;
-  unsigned char *data = (unsigned char *)MemAlloc(width * height * 4);
-  if (data == nullptr) {
-    nsvgDeleteRasterizer(rast);
-    return {0};
-  }
+  // Another thread may have parsed the same icon meanwhile; keep the first
+  std::lock_guard<std::mutex> lock(s_svgMutex);
+  return s_parsedSvgs.emplace(iconKey, std::move(model)).first->second;
+}
+
+// Rasterizes image into data (fullWidth * fullHeight RGBA, zeroed), leaving
+// a transparent border of padding pixels, then whitens RGB for tinting.
+static void RasterizeInto(NSVGrasterizer *rast, NSVGimage *image, int width,
+                          int height, int padding, unsigned char *data) {
+  int fullWidth = width + padding * 2;
+  int fullHeight = height + padding * 2;
+  int stride = fullWidth * 4;
 
   // Scale SVG to fit width/height
   // NSVGimage has width/height.
-  NSVGimage *image = model.GetImage();
   float scaleX = (float)width / image->width;
   float scaleY = (float)height / image->height;
   float scale =
       (scaleX < scaleY) ? scaleX : scaleY; // Maintain aspect ratio? Or fill?
   // Icons are usually square.
 
-  nsvgRasterize(rast, image, 0, 0, scale, data, width, height, stride);
+  nsvgRasterize(rast, image, 0, 0, scale,
+                data + padding * stride + padding * 4, width, height, stride);
 
   // Post-process: Convert all pixels to White (preserving Alpha) so they can be
   // tinted by Raylib
-  int pixelCount = width * height;
+  // Raylib tinting multiplies: Final = Tex * Tint.
+  // If Tex is (0,0,0,A), Final is (0,0,0,A*TintA). Color is lost.
+  // If Tex is (255,255,255,A), Final is (TintR, TintG, TintB, A*TintA).
+  // The transparent border is whitened too so bilinear filtering at the
+  // icon edge does not pull in a dark fringe.
+  int pixelCount = fullWidth * fullHeight;
   for (int i = 0; i < pixelCount; ++i) {
-    // data is RGBA
-    // We only care if there is some opacity.
-    // Actually, we can just set RGB to 255 regardless, relying on Alpha.
-    // But let's be safe and only touch non-transparent ones if needed.
-    // Raylib tinting multiplies: Final = Tex * Tint.
-    // If Tex is (0,0,0,A), Final is (0,0,0,A*TintA). Color is lost.
-    // If Tex is (255,255,255,A), Final is (TintR, TintG, TintB, A*TintA).
-    // Correct.
-
     data[i * 4 + 0] = 255; // R
     data[i * 4 + 1] = 255; // G
     data[i * 4 + 2] = 255; // B
                            // Alpha (data[i*4+3]) remains unchanged
   }
+}
+
+Image SvgRenderer::RasterizeSvg(const char *name, IconVariation variation,
+                                int width, int height, int padding) {
+  Image result = {0};
+  std::shared_ptr<SvgModel> model = GetSvgModel(name, variation);
+  if (model == nullptr || model->GetImage() == nullptr) {
+    return result;
+  }
+
+  // Rasterize using nanosvgrast; the rasterizer keeps its edge and span
+  // buffers between calls
+  if (s_rasterizer == nullptr) {
+    s_rasterizer = nsvgCreateRasterizer();
+    if (s_rasterizer == nullptr) {
+      return result;
+    }
+  }
+
+  // Scratch pixel buffer (RGBA), zeroed so the border stays transparent
+  int fullWidth = width + padding * 2;
+  int fullHeight = height + padding * 2;
+  s_scratchPixels.assign((size_t)fullWidth * fullHeight * 4, 0);
+  unsigned char *data = s_scratchPixels.data();
+
+  RasterizeInto(s_rasterizer, model->GetImage(), width, height, padding, data);
 
-  // Create Raylib Image
-  Image rayImage = {.data = data,
-                    .width = width,
-                    .height = height,
-                    .mipmaps = 1,
-                    .format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8};
+  result = {.data = data,
+            .width = fullWidth,
+            .height = fullHeight,
+            .mipmaps = 1,
+            .format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8};
+  return result;
+}
+
+// Finds room for a w x h rectangle on a page using shelf packing: the
+// shortest existing shelf that fits (without wasting more than half its
+// height), else a new shelf at the bottom, else any shelf that fits.
+static bool AllocateInPage(AtlasPage &page, int w, int h, int &outX,
+                           int &outY) {
+  AtlasShelf *best = nullptr;
+  AtlasShelf *loose = nullptr;
+  for (AtlasShelf &shelf : page.shelves) {
+    if (shelf.height < h || kAtlasPageSize - shelf.x < w)
+      continue;
+    if (shelf.height <= h + h / 2) {
+      if (!best || shelf.height < best->height)
+        best = &shelf;
+    } else if (!loose || shelf.height < loose->height) {
+      loose = &shelf;
+    }
+  }
+
+  if (!best && page.nextShelfY + h <= kAtlasPageSize) {
+    page.shelves.push_back({page.nextShelfY, h, 0});
+    page.nextShelfY += h;
+    best = &page.shelves.back();
+  }
+  if (!best)
+    best = loose;
+  if (!best)
+    return false;
+
+  outX = best->x;
+  outY = best->y;
+  best->x += w;
+  page.usedArea += w * h;
+  page.iconCount++;
+  return true;
+}
+
+static size_t AtlasPageBytes() {
+  return (size_t)kAtlasPageSize * kAtlasPageSize * 4;
+}
+
+// Pages allowed by the limits: maxAtlasPages, but never more than the byte
+// budget can hold (and always at least one)
+static int MaxAtlasPages() {
+  int byBudget = (int)(s_cacheLimits.maxBytes / AtlasPageBytes());
+  return std::max(1, std::min(s_cacheLimits.maxAtlasPages, byBudget));
+}
+
+static size_t ResidentBytes() {
+  return s_atlasPages.size() * AtlasPageBytes() + s_textureBytes;
+}
+
+static void EvictTexture(uint64_t key) {
+  auto it = s_iconEntries.find(key);
+  if (it == s_iconEntries.end() || it->second.page >= 0)
+    return;
+
+  IconCacheEntry &entry = it->second;
+  if (entry.texture.id != 0) {
+    // Draws already batched this frame may still reference the texture
+    rlDrawRenderBatchActive();
+    s_textureBytes -= (size_t)entry.texture.width * entry.texture.height * 4;
+    UnloadTexture(entry.texture);
+    s_textureLru.erase(entry.lru);
+    s_cacheEvictions++;
+  }
+  s_iconEntries.erase(it);
+}
 
-  Texture2D texture = LoadTextureFromImage(rayImage);
+// Evicts least recently used standalone textures until the cache fits its
+// byte budget. The most recent texture is always kept.
+static void EnforceCacheBudget() {
+  while (ResidentBytes() > s_cacheLimits.maxBytes && s_textureLru.size() > 1) {
+    EvictTexture(s_textureLru.back());
+  }
+}
 
-  // Cleanup
-  UnloadImage(rayImage); // Frees data
-  nsvgDeleteRasterizer(rast);
+static void StoreTexture(uint64_t key, Texture2D texture) {
+  IconCacheEntry &entry = s_iconEntries[key];
+  entry.page = -1;
+  entry.texture = texture;
+  if (texture.id == 0)
+    return; // Remembered as failed; holds no memory
+
+  s_textureLru.push_front(key);
+  entry.lru = s_textureLru.begin();
+  s_textureBytes += (size_t)texture.width * texture.height * 4;
+  EnforceCacheBudget();
+}
 
+static bool CreateAtlasPage() {
+  Image blank = GenImageColor(kAtlasPageSize, kAtlasPageSize, BLANK);
+  Texture2D texture = LoadTextureFromImage(blank);
+  UnloadImage(blank);
+  if (texture.id == 0)
+    return false;
   SetTextureFilter(texture, TEXTURE_FILTER_BILINEAR);
-  return texture;
+
+  AtlasPage page;
+  page.texture = texture;
+  s_atlasPages.push_back(page);
+  return true;
+}
+
+// Drops every icon on a page so it can be repacked from scratch
+static void ClearAtlasPage(int pageIndex) {
+  for (auto it = s_iconEntries.begin(); it != s_iconEntries.end();) {
+    if (it->second.page == pageIndex) {
+      it = s_iconEntries.erase(it);
+      s_cacheEvictions++;
+    } else {
+      ++it;
+    }
+  }
+
+  AtlasPage &page = s_atlasPages[pageIndex];
+  page.shelves.clear();
+  page.nextShelfY = 0;
+  page.usedArea = 0;
+  page.iconCount = 0;
+}
+
+// Packs a rasterized (padded) icon into the atlas and uploads it
+static bool InsertIntoAtlas(uint64_t key, const Image &image) {
+  int x = 0, y = 0;
+  int pageIndex = -1;
+  for (size_t i = 0; i < s_atlasPages.size(); ++i) {
+    if (AllocateInPage(s_atlasPages[i], image.width, image.height, x, y)) {
+      pageIndex = (int)i;
+      break;
+    }
+  }
+
+  if (pageIndex < 0 && (int)s_atlasPages.size() < MaxAtlasPages() &&
+      CreateAtlasPage()) {
+    pageIndex = (int)s_atlasPages.size() - 1;
+    if (!AllocateInPage(s_atlasPages[pageIndex], image.width, image.height, x,
+                        y)) {
+      return false;
+    }
+  }
+
+  if (pageIndex < 0) {
+    // All pages full: evict the least recently used page and repack into it
+    pageIndex = 0;
+    for (size_t i = 1; i < s_atlasPages.size(); ++i) {
+      if (s_atlasPages[i].lastUsed < s_atlasPages[pageIndex].lastUsed)
+        pageIndex = (int)i;
+    }
+    ClearAtlasPage(pageIndex);
+    if (!AllocateInPage(s_atlasPages[pageIndex], image.width, image.height, x,
+                        y)) {
+      return false;
+    }
+  }
+
+  // Icons already batched this frame may sample the page we are about to
+  // modify; flush them first
+  rlDrawRenderBatchActive();
+  AtlasPage &page = s_atlasPages[pageIndex];
+  UpdateTextureRec(page.texture,
+                   {(float)x, (float)y, (float)image.width,
+                    (float)image.height},
+                   image.data);
+
+  IconCacheEntry &entry = s_iconEntries[key];
+  entry.page = pageIndex;
+  entry.source = {(float)(x + kAtlasPadding), (float)(y + kAtlasPadding),
+                  (float)(image.width - kAtlasPadding * 2),
+                  (float)(image.height - kAtlasPadding * 2)};
+  entry.texture = {0};
+  page.lastUsed = s_atlasUseCounter;
+
+  // A new page may have pushed standalone textures over budget
+  EnforceCacheBudget();
+  return true;
+}
+
+IconCacheStats SvgRenderer::GetCacheStats() {
+  IconCacheStats stats;
+  stats.pages = (int)s_atlasPages.size();
+  stats.icons = (int)s_iconEntries.size();
+  stats.hits = s_cacheHits;
+  stats.misses = s_cacheMisses;
+  stats.evictions = s_cacheEvictions;
+  stats.residentBytes = ResidentBytes();
+  if (!s_atlasPages.empty()) {
+    long long used = 0;
+    for (const AtlasPage &page : s_atlasPages) {
+      used += page.usedArea;
+    }
+    stats.occupancy = (float)((double)used / ((double)kAtlasPageSize *
+                                               kAtlasPageSize *
+                                               s_atlasPages.size()));
+  }
+  return stats;
+}
+
+void SvgRenderer::SetCacheLimits(const IconCacheLimits &limits) {
+  s_cacheLimits = limits;
+
+  // Drop pages beyond the new limit along with their icons
+  int maxPages = MaxAtlasPages();
+  if ((int)s_atlasPages.size() > maxPages) {
+    rlDrawRenderBatchActive();
+    for (int i = (int)s_atlasPages.size() - 1; i >= maxPages; --i) {
+      ClearAtlasPage(i);
+      UnloadTexture(s_atlasPages[i].texture);
+    }
+    s_atlasPages.resize(maxPages);
+  }
+  EnforceCacheBudget();
+}
+
+const IconCacheLimits &SvgRenderer::GetCacheLimits() { return s_cacheLimits; }
+
+bool SvgRenderer::DrawCachedIcon(uint64_t key, Vector2 position, Color color) {
+  auto it = s_iconEntries.find(key);
+  if (it == s_iconEntries.end())
+    return false;
+
+  s_cacheHits++;
+  IconCacheEntry &entry = it->second;
+  if (entry.page >= 0) {
+    AtlasPage &page = s_atlasPages[entry.page];
+    page.lastUsed = s_atlasUseCounter;
+    DrawTextureRec(page.texture, entry.source, position, color);
+  } else if (entry.texture.id != 0) {
+    s_textureLru.splice(s_textureLru.begin(), s_textureLru, entry.lru);
+    DrawTextureV(entry.texture, position, color);
+  }
+  return true;
+}
+
+void SvgRenderer::StoreRasterizedIcon(uint64_t key, const Image &image,
+                                      int padding) {
+  if (padding > 0 && InsertIntoAtlas(key, image)) {
+    return;
+  }
+
+  Texture2D texture;
+  if (padding > 0) {
+    // Could not pack (should not happen); fall back to a standalone texture
+    Image cropped =
+        ImageFromImage(image, {(float)padding, (float)padding,
+                               (float)(image.width - padding * 2),
+                               (float)(image.height - padding * 2)});
+    texture = LoadTextureFromImage(cropped);
+    UnloadImage(cropped);
+  } else {
+    texture = LoadTextureFromImage(image);
+  }
+  if (texture.id == 0)
+    return;
+  SetTextureFilter(texture, TEXTURE_FILTER_BILINEAR);
+  StoreTexture(key, texture);
 }
 
 void SvgRenderer::DrawIcon(const char *name, Rectangle bounds,
@@ -191,21 +684,330 @@ void SvgRenderer::DrawIcon(const char *name, Rectangle bounds,
   if (width <= 0 || height <= 0)
     return;
 
-  std::string key = GetCacheKey(name, variation, width, height);
+  if (s_sdfMode) {
+    DrawIconSdf(name, bounds, variation, color);
+    return;
+  }
 
-  Texture2D texture;
-  auto it = textureCache.find(key);
-  if (it != textureCache.end()) {
-    texture = it->second;
-  } else {
-    texture = LoadSvgTexture(name, variation, width, height);
+  uint64_t key = GetCacheKey(name, variation, width, height);
+  Vector2 position = {(float)(int)bounds.x, (float)(int)bounds.y};
+  s_atlasUseCounter++;
+
+  if (DrawCachedIcon(key, position, color))
+    return;
+  s_cacheMisses++;
+
+  bool fitsAtlas = width + kAtlasPadding * 2 <= kAtlasPageSize &&
+                   height + kAtlasPadding * 2 <= kAtlasPageSize;
+  int padding = fitsAtlas ? kAtlasPadding : 0;
+
+  if (s_loaderOptions.async) {
+    // Queue the icon once; it appears after a later ProcessPendingUploads
+    if (s_pendingIcons.insert(key).second) {
+      {
+        std::lock_guard<std::mutex> lock(s_iconJobMutex);
+        s_iconJobs.push_back({key, name, variation, width, height, padding});
+      }
+      s_iconJobCondition.notify_one();
+    }
+    if (s_loaderOptions.drawPlaceholder) {
+      Renderer::DrawRoundedRectangle(
+          bounds, std::min(bounds.width, bounds.height) * 0.25f,
+          ColorAlpha(color, 0.12f));
+    }
+    return;
+  }
+
+  Image image = RasterizeSvg(name, variation, width, height, padding);
+  if (image.data == nullptr)
+    return;
+
+  StoreRasterizedIcon(key, image, padding);
+  DrawCachedIcon(key, position, color);
+}
+
+// One pass of Felzenszwalb & Huttenlocher's exact squared Euclidean distance
+// transform over n samples (f in, d out; v and z are scratch of n and n + 1)
+static void DistanceTransform1D(const float *f, float *d, int *v, float *z,
+                                int n) {
+  const float inf = 1e20f;
+  int k = 0;
+  v[0] = 0;
+  z[0] = -inf;
+  z[1] = inf;
+  for (int q = 1; q < n; ++q) {
+    float s;
+    while (true) {
+      s = ((f[q] + (float)(q * q)) - (f[v[k]] + (float)(v[k] * v[k]))) /
+          (float)(2 * q - 2 * v[k]);
+      if (s > z[k])
+        break;
+      k--;
+    }
+    k++;
+    v[k] = q;
+    z[k] = s;
+    z[k + 1] = inf;
+  }
+
+  k = 0;
+  for (int q = 0; q < n; ++q) {
+    while (z[k + 1] < (float)q)
+      k++;
+    float dq = (float)(q - v[k]);
+    d[q] = dq * dq + f[v[k]];
+  }
+}
+
+// Distance (in pixels) from every pixel to the nearest pixel where
+// feature[i] is true
+static void DistanceTransform2D(const std::vector<bool> &feature, int width,
+                                int height, std::vector<float> &out) {
+  const float inf = 1e20f;
+  int n = std::max(width, height);
+  std::vector<float> f(n), d(n), z(n + 1);
+  std::vector<int> v(n);
+
+  out.resize((size_t)width * height);
+  for (size_t i = 0; i < out.size(); ++i) {
+    out[i] = feature[i] ? 0.0f : inf;
+  }
+
+  for (int x = 0; x < width; ++x) {
+    for (int y = 0; y < height; ++y)
+      f[y] = out[y * width + x];
+    DistanceTransform1D(f.data(), d.data(), v.data(), z.data(), height);
+    for (int y = 0; y < height; ++y)
+      out[y * width + x] = d[y];
+  }
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x)
+      f[x] = out[y * width + x];
+    DistanceTransform1D(f.data(), d.data(), v.data(), z.data(), width);
+    for (int x = 0; x < width; ++x)
+      out[y * width + x] = std::sqrt(d[x]);
+  }
+}
+
+Texture2D SvgRenderer::GetSdfTexture(const char *name,
+                                     IconVariation variation) {
+  uint64_t key = GetCacheKey(name, variation, 0, 0, true);
+  auto it = s_iconEntries.find(key);
+  if (it != s_iconEntries.end()) {
+    s_cacheHits++;
+    IconCacheEntry &entry = it->second;
+    if (entry.texture.id != 0) {
+      s_textureLru.splice(s_textureLru.begin(), s_textureLru, entry.lru);
+    }
+    return entry.texture; // id == 0 for icons that failed to load
+  }
+  s_cacheMisses++;
+
+  Texture2D texture = {0};
+  Image image = RasterizeSvg(name, variation, kSdfReferenceSize,
+                             kSdfReferenceSize, kSdfSpread);
+  if (image.data != nullptr) {
+    int width = image.width;
+    int height = image.height;
+    unsigned char *pixels = (unsigned char *)image.data;
+    size_t count = (size_t)width * height;
+
+    std::vector<bool> inside(count), outside(count);
+    for (size_t i = 0; i < count; ++i) {
+      inside[i] = pixels[i * 4 + 3] >= 128;
+      outside[i] = !inside[i];
+    }
+    std::vector<float> toInside, toOutside;
+    DistanceTransform2D(inside, width, height, toInside);
+    DistanceTransform2D(outside, width, height, toOutside);
+
+    // Signed distance to the outline (positive inside), measured between
+    // pixel centres so the edge sits half a pixel from each side. Encoded
+    // as 0.5 + d / (2 * spread) in the alpha channel; RGB stays white.
+    for (size_t i = 0; i < count; ++i) {
+      float d = inside[i] ? toOutside[i] - 0.5f : -(toInside[i] - 0.5f);
+      float value = 0.5f + d / (2.0f * kSdfSpread);
+      value = std::clamp(value, 0.0f, 1.0f);
+      pixels[i * 4 + 3] = (unsigned char)(value * 255.0f + 0.5f);
+    }
+
+    texture = LoadTextureFromImage(image);
     if (texture.id != 0) {
-      textureCache[key] = texture;
+      SetTextureFilter(texture, TEXTURE_FILTER_BILINEAR);
+    }
+  }
+
+  StoreTexture(key, texture);
+  return texture;
+}
+
+void SvgRenderer::DrawIconSdf(const char *name, Rectangle bounds,
+                              IconVariation variation, Color color) {
+  if (bounds.width <= 0 || bounds.height <= 0)
+    return;
+
+  Texture2D texture = GetSdfTexture(name, variation);
+  if (texture.id == 0)
+    return;
+
+  // The texture includes the spread border around the icon, so the
+  // destination grows by the same (scaled) amount
+  float scaleX = bounds.width / kSdfReferenceSize;
+  float scaleY = bounds.height / kSdfReferenceSize;
+  Rectangle source = {0, 0, (float)texture.width, (float)texture.height};
+  Rectangle dest = {bounds.x - kSdfSpread * scaleX,
+                    bounds.y - kSdfSpread * scaleY, texture.width * scaleX,
+                    texture.height * scaleY};
+
+  // One screen pixel spans 1 / scale reference pixels, i.e.
+  // 1 / (2 * spread * scale) in encoded units; smooth over about one pixel
+  float scale = std::max(0.01f, std::min(scaleX, scaleY));
+  float smoothing = 0.5f / (2.0f * kSdfSpread * scale);
+
+  // Drawn under the renderer's shape shader (smoothing travels per vertex),
+  // so inside a shape batch consecutive icons and shapes do not switch
+  // shaders. The dedicated shader is only a fallback.
+  if (Renderer::DrawDistanceField(texture, source, dest, smoothing, color))
+    return;
+
+  if (!s_sdfShaderLoaded) {
+    s_sdfShader = LoadShaderFromMemory(0, sdfFragShader330);
+    if (s_sdfShader.id == rlGetShaderIdDefault()) {
+      // Fallback to GLSL 100
+      s_sdfShader = LoadShaderFromMemory(0, sdfFragShader100);
+    }
+    s_sdfShaderLocSmoothing = GetShaderLocation(s_sdfShader, "smoothing");
+    s_sdfShaderLoaded = true;
+  }
+
+  BeginShaderMode(s_sdfShader);
+  SetShaderValue(s_sdfShader, s_sdfShaderLocSmoothing, &smoothing,
+                 SHADER_UNIFORM_FLOAT);
+  DrawTexturePro(texture, source, dest, {0, 0}, 0.0f, color);
+  EndShaderMode();
+}
+
+void SvgRenderer::SetSdfMode(bool enabled) { s_sdfMode = enabled; }
+
+bool SvgRenderer::IsSdfMode() { return s_sdfMode; }
+
+void SvgRenderer::RunIconWorker() {
+  NSVGrasterizer *rast = nsvgCreateRasterizer();
+
+  while (true) {
+    IconJob job;
+    {
+      std::unique_lock<std::mutex> lock(s_iconJobMutex);
+      s_iconJobCondition.wait(
+          lock, [] { return s_stopIconWorkers || !s_iconJobs.empty(); });
+      if (s_stopIconWorkers)
+        break;
+      job = std::move(s_iconJobs.front());
+      s_iconJobs.pop_front();
+    }
+
+    IconJobResult result;
+    result.key = std::move(job.key);
+    result.width = job.width;
+    result.height = job.height;
+    result.padding = job.padding;
+
+    std::shared_ptr<SvgModel> model = GetSvgModel(job.name.c_str(), job.variation);
+    if (rast && model && model->GetImage()) {
+      int fullWidth = job.width + job.padding * 2;
+      int fullHeight = job.height + job.padding * 2;
+      // MemAlloc returns zeroed memory, so the border starts transparent
+      unsigned char *data =
+          (unsigned char *)MemAlloc(fullWidth * fullHeight * 4);
+      if (data) {
+        RasterizeInto(rast, model->GetImage(), job.width, job.height,
+                      job.padding, data);
+        result.image = {.data = data,
+                        .width = fullWidth,
+                        .height = fullHeight,
+                        .mipmaps = 1,
+                        .format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8};
+      }
     }
+
+    std::lock_guard<std::mutex> lock(s_iconJobMutex);
+    s_finishedIcons.push_back(std::move(result));
   }
 
-  if (texture.id != 0) {
-    DrawTexture(texture, (int)bounds.x, (int)bounds.y, color);
+  if (rast) {
+    nsvgDeleteRasterizer(rast);
+  }
+}
+
+void SvgRenderer::StartIconWorkers(int count) {
+  s_stopIconWorkers = false;
+  for (int i = 0; i < count; ++i) {
+    s_iconWorkers.emplace_back(RunIconWorker);
+  }
+}
+
+void SvgRenderer::StopIconWorkers() {
+  {
+    std::lock_guard<std::mutex> lock(s_iconJobMutex);
+    s_stopIconWorkers = true;
+  }
+  s_iconJobCondition.notify_all();
+  for (std::thread &worker : s_iconWorkers) {
+    worker.join();
+  }
+  s_iconWorkers.clear();
+
+  // Drop queued and unuploaded work; those icons are requested again on
+  // their next DrawIcon
+  s_iconJobs.clear();
+  for (IconJobResult &result : s_finishedIcons) {
+    if (result.image.data) {
+      UnloadImage(result.image);
+    }
+  }
+  s_finishedIcons.clear();
+  s_pendingIcons.clear();
+}
+
+void SvgRenderer::SetLoaderOptions(const IconLoaderOptions &options) {
+  StopIconWorkers();
+  s_loaderOptions = options;
+  if (s_loaderOptions.async) {
+    StartIconWorkers(std::max(1, s_loaderOptions.workerCount));
+  }
+}
+
+const IconLoaderOptions &SvgRenderer::GetLoaderOptions() {
+  return s_loaderOptions;
+}
+
+void SvgRenderer::ProcessPendingUploads() {
+  if (!s_loaderOptions.async)
+    return;
+
+  // Take at most uploadsPerFrame finished icons; the rest wait for the next
+  // frame so a burst of new icons does not cause a hitch
+  std::vector<IconJobResult> ready;
+  {
+    std::lock_guard<std::mutex> lock(s_iconJobMutex);
+    size_t budget = (size_t)std::max(1, s_loaderOptions.uploadsPerFrame);
+    size_t count = std::min(budget, s_finishedIcons.size());
+    ready.assign(std::make_move_iterator(s_finishedIcons.begin()),
+                 std::make_move_iterator(s_finishedIcons.begin() + count));
+    s_finishedIcons.erase(s_finishedIcons.begin(),
+                          s_finishedIcons.begin() + count);
+  }
+
+  for (IconJobResult &result : ready) {
+    if (result.image.data == nullptr) {
+      // Remembered as failed, so it is neither queued again nor drawn as a
+      // placeholder
+      StoreTexture(result.key, {0});
+    } else {
+      StoreRasterizedIcon(result.key, result.image, result.padding);
+      UnloadImage(result.image);
+    }
+    s_pendingIcons.erase(result.key);
   }
 }
 
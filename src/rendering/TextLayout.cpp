@@ -0,0 +1,248 @@
+#include "raym3/rendering/TextLayout.h"
+#include "raym3/fonts/FontManager.h"
+#include "raym3/rendering/Renderer.h"
+#include "raym3/styles/Theme.h"
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+namespace raym3 {
+
+namespace {
+
+// Layouts are dropped wholesale past this count, like the measurement cache
+constexpr size_t kMaxLayouts = 256;
+
+std::unordered_map<uint64_t, TextLayoutResult> s_layouts;
+TextLayoutStats s_stats;
+uint32_t s_glyphGeneration = 0;
+
+// Scratch buffers reused across layouts
+std::vector<int> s_codepoints;
+
+struct LineRange {
+  int start; // Codepoint indices, end exclusive
+  int end;
+};
+std::vector<LineRange> s_ranges;
+
+void HashBytes(uint64_t &hash, const void *data, size_t size) {
+  const unsigned char *bytes = static_cast<const unsigned char *>(data);
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ull;
+  }
+}
+
+uint64_t LayoutKey(const char *text, float maxWidth, float fontSize,
+                   FontWeight weight, const TextLayoutOptions &options) {
+  uint64_t hash = 14695981039346656037ull;
+  HashBytes(hash, text, std::strlen(text));
+  int params[] = {(int)weight, (int)options.alignment, options.maxLines,
+                  options.ellipsis ? 1 : 0};
+  float metrics[] = {maxWidth, fontSize, options.lineHeight};
+  HashBytes(hash, params, sizeof(params));
+  HashBytes(hash, metrics, sizeof(metrics));
+  return hash;
+}
+
+// Guards against LayoutKey collisions
+bool SameLayout(const TextLayoutResult &result, const char *text,
+                float maxWidth, float fontSize, FontWeight weight,
+                const TextLayoutOptions &options) {
+  return result.maxWidth == maxWidth && result.fontSize == fontSize &&
+         result.weight == weight &&
+         result.options.alignment == options.alignment &&
+         result.options.maxLines == options.maxLines &&
+         result.options.ellipsis == options.ellipsis &&
+         result.options.lineHeight == options.lineHeight &&
+         result.text == text;
+}
+
+// Splits the codepoints into lines. Spaces hang past the edge and are
+// trimmed from line ends; a word wider than a line breaks between glyphs.
+void BreakLines(const TextAdvances &advances, float maxWidth) {
+  const std::vector<int> &cps = s_codepoints;
+  bool wrap = maxWidth > 0.0f;
+  int start = 0;
+  int lastSpace = -1;
+
+  s_ranges.clear();
+  for (int i = 0; i < advances.count; ++i) {
+    if (cps[i] == '\n') {
+      s_ranges.push_back({start, i});
+      start = i + 1;
+      lastSpace = -1;
+      continue;
+    }
+    if (cps[i] == ' ') {
+      lastSpace = i;
+      continue;
+    }
+    if (wrap && i > start && advances.x[i + 1] - advances.x[start] > maxWidth) {
+      if (lastSpace > start) {
+        s_ranges.push_back({start, lastSpace});
+        start = lastSpace + 1;
+      } else {
+        s_ranges.push_back({start, i});
+        start = i;
+      }
+      lastSpace = -1;
+    }
+  }
+  s_ranges.push_back({start, advances.count});
+
+  for (LineRange &range : s_ranges) {
+    while (range.end > range.start && cps[range.end - 1] == ' ')
+      range.end--;
+  }
+}
+
+void BuildLayout(TextLayoutResult &result, const char *text, float maxWidth,
+                 float fontSize, FontWeight weight,
+                 const TextLayoutOptions &options) {
+  result.text = text;
+  result.maxWidth = maxWidth;
+  result.options = options;
+  result.fontSize = fontSize;
+  result.weight = weight;
+  result.lineHeight =
+      options.lineHeight > 0.0f ? options.lineHeight : fontSize * 1.2f;
+
+  // Measured before GetTextAdvances, whose arrays a later measurement
+  // could invalidate
+  float dotWidth = Renderer::MeasureText(".", fontSize, weight).x;
+
+  TextAdvances advances = Renderer::GetTextAdvances(text, fontSize, weight);
+  if (advances.count == 0)
+    return;
+
+  s_codepoints.resize(advances.count);
+  for (int i = 0; i < advances.count; ++i) {
+    int byteCount = 0;
+    s_codepoints[i] =
+        GetCodepointNext(text + advances.byteOffsets[i], &byteCount);
+  }
+
+  BreakLines(advances, maxWidth);
+
+  bool ellipsize = false;
+  if (options.maxLines > 0 && (int)s_ranges.size() > options.maxLines) {
+    s_ranges.resize(options.maxLines);
+    result.truncated = true;
+    ellipsize = options.ellipsis;
+  }
+
+  if (ellipsize) {
+    // Shorten the last line until it fits with the ellipsis
+    LineRange &last = s_ranges.back();
+    float limit = maxWidth > 0.0f ? maxWidth - 3.0f * dotWidth : 1e30f;
+    while (last.end > last.start &&
+           advances.x[last.end] - advances.x[last.start] > limit)
+      last.end--;
+    while (last.end > last.start && s_codepoints[last.end - 1] == ' ')
+      last.end--;
+  }
+
+  float widest = 0.0f;
+  for (size_t l = 0; l < s_ranges.size(); ++l) {
+    const LineRange &range = s_ranges[l];
+    float width = advances.x[range.end] - advances.x[range.start];
+    if (ellipsize && l + 1 == s_ranges.size())
+      width += 3.0f * dotWidth;
+    result.lines.push_back({0, 0, advances.byteOffsets[range.start],
+                            advances.byteOffsets[range.end], width});
+    widest = std::max(widest, width);
+  }
+
+  float alignWidth = maxWidth > 0.0f ? maxWidth : widest;
+  float baselineOffset = (result.lineHeight - fontSize) / 2.0f;
+  for (size_t l = 0; l < s_ranges.size(); ++l) {
+    const LineRange &range = s_ranges[l];
+    TextLayoutLine &line = result.lines[l];
+
+    float lineX = 0.0f;
+    if (options.alignment == TextAlignment::Center) {
+      lineX = (alignWidth - line.width) / 2.0f;
+    } else if (options.alignment == TextAlignment::Right) {
+      lineX = alignWidth - line.width;
+    }
+    float y = (float)l * result.lineHeight + baselineOffset;
+
+    line.firstGlyph = (int)result.glyphs.size();
+    for (int i = range.start; i < range.end; ++i) {
+      if (s_codepoints[i] == ' ')
+        continue; // Nothing to draw
+      float x = lineX + advances.x[i] - advances.x[range.start];
+      result.glyphs.push_back({s_codepoints[i], {x, y}});
+    }
+    if (ellipsize && l + 1 == s_ranges.size()) {
+      float x = lineX + advances.x[range.end] - advances.x[range.start];
+      for (int d = 0; d < 3; ++d) {
+        result.glyphs.push_back({'.', {x + d * dotWidth, y}});
+      }
+    }
+    line.glyphCount = (int)result.glyphs.size() - line.firstGlyph;
+  }
+
+  result.size = {widest, (float)result.lines.size() * result.lineHeight};
+}
+
+} // namespace
+
+const TextLayoutResult &TextLayout::Layout(const char *text, float maxWidth,
+                                           float fontSize, FontWeight weight,
+                                           const TextLayoutOptions &options) {
+  static const TextLayoutResult empty;
+  if (!text || text[0] == '\0')
+    return empty;
+
+  // New glyphs change advances, so older layouts are stale
+  if (FontManager::GetGlyphGeneration() != s_glyphGeneration) {
+    s_layouts.clear();
+    s_glyphGeneration = FontManager::GetGlyphGeneration();
+  }
+
+  uint64_t key = LayoutKey(text, maxWidth, fontSize, weight, options);
+  auto cached = s_layouts.find(key);
+  if (cached != s_layouts.end() &&
+      SameLayout(cached->second, text, maxWidth, fontSize, weight, options)) {
+    s_stats.hits++;
+    return cached->second;
+  }
+  s_stats.misses++;
+
+  if (s_layouts.size() >= kMaxLayouts) {
+    s_layouts.clear();
+  }
+  TextLayoutResult &result = s_layouts[key];
+  result = TextLayoutResult(); // A colliding layout is replaced
+  BuildLayout(result, text, maxWidth, fontSize, weight, options);
+  // Building may have loaded glyphs; the result already accounts for them
+  s_glyphGeneration = FontManager::GetGlyphGeneration();
+  return result;
+}
+
+void TextLayout::Draw(const TextLayoutResult &layout, Vector2 origin,
+                      Color color) {
+  if (layout.glyphs.empty())
+    return;
+
+  Font font = Theme::GetFont(layout.fontSize, layout.weight);
+  for (const TextLayoutGlyph &glyph : layout.glyphs) {
+    Vector2 position = {origin.x + glyph.position.x,
+                        origin.y + glyph.position.y};
+    DrawTextCodepoint(font, glyph.codepoint, position, layout.fontSize,
+                      color);
+  }
+}
+
+TextLayoutStats TextLayout::GetStats() {
+  TextLayoutStats stats = s_stats;
+  stats.entries = s_layouts.size();
+  return stats;
+}
+
+void TextLayout::ClearCache() { s_layouts.clear(); }
+
+} // namespace raym3
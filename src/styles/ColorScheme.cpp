@@ -1,9 +1,51 @@
 #include "raym3/styles/ColorScheme.h"
+#include "styles/Hct.h"
 #include <algorithm>
 #include <cmath>
+#include <unordered_map>
 
 namespace raym3 {
 
+namespace {
+
+// Material "tonal spot" key palettes derived from one seed
+struct CorePalette {
+  TonalPalette primary;
+  TonalPalette secondary;
+  TonalPalette tertiary;
+  TonalPalette neutral;
+  TonalPalette neutralVariant;
+  TonalPalette error;
+};
+
+// Both memoized per seed: palettes keep every tone they have solved, and
+// finished schemes make switching tenants or light/dark a map lookup
+std::unordered_map<uint32_t, CorePalette> s_corePalettes;
+std::unordered_map<uint64_t, ColorScheme> s_seedSchemes;
+
+uint32_t PackRgb(Color color) {
+  return ((uint32_t)color.r << 16) | ((uint32_t)color.g << 8) | color.b;
+}
+
+CorePalette &GetCorePalette(Color seed) {
+  uint32_t key = PackRgb(seed);
+  auto it = s_corePalettes.find(key);
+  if (it != s_corePalettes.end())
+    return it->second;
+
+  Hct hct = HctFromColor(seed);
+  CorePalette palette;
+  palette.primary = TonalPalette(hct.hue, std::max(48.0, hct.chroma));
+  palette.secondary = TonalPalette(hct.hue, 16.0);
+  palette.tertiary = TonalPalette(hct.hue + 60.0, 24.0);
+  palette.neutral = TonalPalette(hct.hue, 4.0);
+  palette.neutralVariant = TonalPalette(hct.hue, 8.0);
+  palette.error = TonalPalette(25.0, 84.0);
+  return s_corePalettes.emplace(key, palette).first->second;
+}
+
+} // namespace
+
 ColorScheme ColorScheme::Light() {
   ColorScheme scheme;
 
@@ -99,11 +141,68 @@ ColorScheme ColorScheme::Dark() {
 }
 
 ColorScheme ColorScheme::FromSeed(Color seedColor, bool darkMode) {
-  if (darkMode) {
-    return Dark();
-  } else {
-    return Light();
-  }
+  uint64_t key = ((uint64_t)PackRgb(seedColor) << 1) | (darkMode ? 1 : 0);
+  auto cached = s_seedSchemes.find(key);
+  if (cached != s_seedSchemes.end())
+    return cached->second;
+
+  CorePalette &p = GetCorePalette(seedColor);
+  ColorScheme scheme;
+
+  // Tones follow the Material 3 baseline light and dark schemes
+  int accent = darkMode ? 80 : 40;
+  int onAccent = darkMode ? 20 : 100;
+  int container = darkMode ? 30 : 90;
+  int onContainer = darkMode ? 90 : 10;
+
+  scheme.primary = p.primary.Tone(accent);
+  scheme.onPrimary = p.primary.Tone(onAccent);
+  scheme.primaryContainer = p.primary.Tone(container);
+  scheme.onPrimaryContainer = p.primary.Tone(onContainer);
+
+  scheme.secondary = p.secondary.Tone(accent);
+  scheme.onSecondary = p.secondary.Tone(onAccent);
+  scheme.secondaryContainer = p.secondary.Tone(container);
+  scheme.onSecondaryContainer = p.secondary.Tone(onContainer);
+
+  scheme.tertiary = p.tertiary.Tone(accent);
+  scheme.onTertiary = p.tertiary.Tone(onAccent);
+  scheme.tertiaryContainer = p.tertiary.Tone(container);
+  scheme.onTertiaryContainer = p.tertiary.Tone(onContainer);
+
+  scheme.error = p.error.Tone(accent);
+  scheme.onError = p.error.Tone(onAccent);
+  scheme.errorContainer = p.error.Tone(container);
+  scheme.onErrorContainer = p.error.Tone(onContainer);
+
+  scheme.surface = p.neutral.Tone(darkMode ? 6 : 98);
+  scheme.onSurface = p.neutral.Tone(darkMode ? 90 : 10);
+  scheme.surfaceVariant = p.neutralVariant.Tone(darkMode ? 30 : 90);
+  scheme.onSurfaceVariant = p.neutralVariant.Tone(darkMode ? 80 : 30);
+
+  scheme.surfaceContainerLowest = p.neutral.Tone(darkMode ? 4 : 100);
+  scheme.surfaceContainerLow = p.neutral.Tone(darkMode ? 10 : 96);
+  scheme.surfaceContainer = p.neutral.Tone(darkMode ? 12 : 94);
+  scheme.surfaceContainerHigh = p.neutral.Tone(darkMode ? 17 : 92);
+  scheme.surfaceContainerHighest = p.neutral.Tone(darkMode ? 22 : 90);
+
+  scheme.outline = p.neutralVariant.Tone(darkMode ? 60 : 50);
+  scheme.outlineVariant = p.neutralVariant.Tone(darkMode ? 30 : 80);
+
+  scheme.shadow = p.neutral.Tone(0);
+  scheme.scrim = p.neutral.Tone(0);
+
+  scheme.inverseSurface = p.neutral.Tone(darkMode ? 90 : 20);
+  scheme.inverseOnSurface = p.neutral.Tone(darkMode ? 20 : 95);
+  scheme.inversePrimary = p.primary.Tone(darkMode ? 40 : 80);
+
+  s_seedSchemes.emplace(key, scheme);
+  return scheme;
+}
+
+void ColorScheme::ClearSeedCache() {
+  s_seedSchemes.clear();
+  s_corePalettes.clear();
 }
 
 Color ColorScheme::Blend(Color color1, Color color2, float ratio) {
@@ -0,0 +1,268 @@
+#include "styles/Hct.h"
+#include <algorithm>
+#include <cmath>
+
+namespace raym3 {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+double SrgbToLinear(int channel) {
+  double normalized = channel / 255.0;
+  if (normalized <= 0.040449936)
+    return normalized / 12.92 * 100.0;
+  return std::pow((normalized + 0.055) / 1.055, 2.4) * 100.0;
+}
+
+int LinearToSrgb(double linear) {
+  double normalized = linear / 100.0;
+  double delinearized = normalized <= 0.0031308
+                            ? normalized * 12.92
+                            : 1.055 * std::pow(normalized, 1.0 / 2.4) - 0.055;
+  return std::clamp((int)std::round(delinearized * 255.0), 0, 255);
+}
+
+double LabF(double t) {
+  const double e = 216.0 / 24389.0;
+  const double kappa = 24389.0 / 27.0;
+  return t > e ? std::cbrt(t) : (kappa * t + 16.0) / 116.0;
+}
+
+double LabInvF(double ft) {
+  const double e = 216.0 / 24389.0;
+  const double kappa = 24389.0 / 27.0;
+  double ft3 = ft * ft * ft;
+  return ft3 > e ? ft3 : (116.0 * ft - 16.0) / kappa;
+}
+
+double YFromLstar(double lstar) { return 100.0 * LabInvF((lstar + 16.0) / 116.0); }
+
+double LstarFromY(double y) { return 116.0 * LabF(y / 100.0) - 16.0; }
+
+// CAM16 viewing conditions for sRGB (D65, background L* 50, average
+// surround), as used by Material color utilities
+struct ViewingConditions {
+  double n, aw, nbb, ncb, c, nc, fl, fLRoot, z;
+  double rgbD[3];
+
+  ViewingConditions() {
+    const double white[3] = {95.047, 100.0, 108.883};
+    double adaptingLuminance = (200.0 / kPi) * YFromLstar(50.0) / 100.0;
+    double surround = 2.0;
+
+    double rW = white[0] * 0.401288 + white[1] * 0.650173 + white[2] * -0.051461;
+    double gW = white[0] * -0.250268 + white[1] * 1.204414 + white[2] * 0.045854;
+    double bW = white[0] * -0.002079 + white[1] * 0.048952 + white[2] * 0.953127;
+
+    double f = 0.8 + surround / 10.0;
+    c = f >= 0.9 ? 0.59 + (0.69 - 0.59) * ((f - 0.9) * 10.0)
+                 : 0.525 + (0.59 - 0.525) * ((f - 0.8) * 10.0);
+    double d = f * (1.0 - (1.0 / 3.6) * std::exp((-adaptingLuminance - 42.0) / 92.0));
+    d = std::clamp(d, 0.0, 1.0);
+    nc = f;
+    rgbD[0] = d * (100.0 / rW) + 1.0 - d;
+    rgbD[1] = d * (100.0 / gW) + 1.0 - d;
+    rgbD[2] = d * (100.0 / bW) + 1.0 - d;
+
+    double k = 1.0 / (5.0 * adaptingLuminance + 1.0);
+    double k4 = k * k * k * k;
+    double k4F = 1.0 - k4;
+    fl = k4 * adaptingLuminance +
+         0.1 * k4F * k4F * std::cbrt(5.0 * adaptingLuminance);
+    n = YFromLstar(50.0) / white[1];
+    z = 1.48 + std::sqrt(n);
+    nbb = 0.725 / std::pow(n, 0.2);
+    ncb = nbb;
+
+    double rgbW[3] = {rW, gW, bW};
+    double rgbA[3];
+    for (int i = 0; i < 3; ++i) {
+      double factor = std::pow(fl * rgbD[i] * rgbW[i] / 100.0, 0.42);
+      rgbA[i] = 400.0 * factor / (factor + 27.13);
+    }
+    aw = (2.0 * rgbA[0] + rgbA[1] + 0.05 * rgbA[2]) * nbb;
+    fLRoot = std::pow(fl, 0.25);
+  }
+};
+
+const ViewingConditions &Conditions() {
+  static const ViewingConditions conditions;
+  return conditions;
+}
+
+// CAM16 lightness J plus hue and chroma from linear XYZ
+void XyzToCam16(const double xyz[3], double &j, double &chroma, double &hue) {
+  const ViewingConditions &vc = Conditions();
+  double rC = 0.401288 * xyz[0] + 0.650173 * xyz[1] - 0.051461 * xyz[2];
+  double gC = -0.250268 * xyz[0] + 1.204414 * xyz[1] + 0.045854 * xyz[2];
+  double bC = -0.002079 * xyz[0] + 0.048952 * xyz[1] + 0.953127 * xyz[2];
+  double cone[3] = {rC * vc.rgbD[0], gC * vc.rgbD[1], bC * vc.rgbD[2]};
+
+  double adapted[3];
+  for (int i = 0; i < 3; ++i) {
+    double af = std::pow(vc.fl * std::abs(cone[i]) / 100.0, 0.42);
+    adapted[i] = std::copysign(400.0 * af / (af + 27.13), cone[i]);
+  }
+  double rA = adapted[0], gA = adapted[1], bA = adapted[2];
+
+  double a = (11.0 * rA - 12.0 * gA + bA) / 11.0;
+  double b = (rA + gA - 2.0 * bA) / 9.0;
+  double u = (20.0 * rA + 20.0 * gA + 21.0 * bA) / 20.0;
+  double p2 = (40.0 * rA + 20.0 * gA + bA) / 20.0;
+
+  hue = std::atan2(b, a) * 180.0 / kPi;
+  if (hue < 0.0)
+    hue += 360.0;
+  else if (hue >= 360.0)
+    hue -= 360.0;
+
+  double ac = p2 * vc.nbb;
+  j = 100.0 * std::pow(ac / vc.aw, vc.c * vc.z);
+
+  double huePrime = hue < 20.14 ? hue + 360.0 : hue;
+  double eHue = 0.25 * (std::cos(huePrime * kPi / 180.0 + 2.0) + 3.8);
+  double p1 = 50000.0 / 13.0 * eHue * vc.nc * vc.ncb;
+  double t = p1 * std::hypot(a, b) / (u + 0.305);
+  double alpha = std::pow(t, 0.9) * std::pow(1.64 - std::pow(0.29, vc.n), 0.73);
+  chroma = alpha * std::sqrt(j / 100.0);
+}
+
+// Inverse of XyzToCam16
+void Cam16ToXyz(double j, double chroma, double hue, double xyz[3]) {
+  const ViewingConditions &vc = Conditions();
+  double alpha = (chroma == 0.0 || j == 0.0) ? 0.0 : chroma / std::sqrt(j / 100.0);
+  double t = std::pow(alpha / std::pow(1.64 - std::pow(0.29, vc.n), 0.73),
+                      1.0 / 0.9);
+  double hRad = hue * kPi / 180.0;
+  double eHue = 0.25 * (std::cos(hRad + 2.0) + 3.8);
+  double ac = vc.aw * std::pow(j / 100.0, 1.0 / vc.c / vc.z);
+  double p1 = eHue * (50000.0 / 13.0) * vc.nc * vc.ncb;
+  double p2 = ac / vc.nbb;
+  double hSin = std::sin(hRad);
+  double hCos = std::cos(hRad);
+
+  double gamma = 23.0 * (p2 + 0.305) * t /
+                 (23.0 * p1 + 11.0 * t * hCos + 108.0 * t * hSin);
+  double a = gamma * hCos;
+  double b = gamma * hSin;
+  double rA = (460.0 * p2 + 451.0 * a + 288.0 * b) / 1403.0;
+  double gA = (460.0 * p2 - 891.0 * a - 261.0 * b) / 1403.0;
+  double bA = (460.0 * p2 - 220.0 * a - 6300.0 * b) / 1403.0;
+
+  double adapted[3] = {rA, gA, bA};
+  double cone[3];
+  for (int i = 0; i < 3; ++i) {
+    double base = std::max(0.0, 27.13 * std::abs(adapted[i]) /
+                                    (400.0 - std::abs(adapted[i])));
+    cone[i] = std::copysign(100.0 / vc.fl * std::pow(base, 1.0 / 0.42),
+                            adapted[i]) /
+              vc.rgbD[i];
+  }
+  xyz[0] = 1.86206786 * cone[0] - 1.01125463 * cone[1] + 0.14918677 * cone[2];
+  xyz[1] = 0.38752654 * cone[0] + 0.62144744 * cone[1] - 0.00897398 * cone[2];
+  xyz[2] = -0.01584150 * cone[0] - 0.03412294 * cone[1] + 1.04996444 * cone[2];
+}
+
+void XyzToLinearRgb(const double xyz[3], double rgb[3]) {
+  rgb[0] = 3.2413774792388685 * xyz[0] - 1.5376652402851851 * xyz[1] -
+           0.49885366846268053 * xyz[2];
+  rgb[1] = -0.9691452513005321 * xyz[0] + 1.8758853451067872 * xyz[1] +
+           0.04156585616912061 * xyz[2];
+  rgb[2] = 0.05562093689691305 * xyz[0] - 0.20395524564742123 * xyz[1] +
+           1.0571799111220335 * xyz[2];
+}
+
+Color GrayFromLstar(double lstar) {
+  int value = LinearToSrgb(YFromLstar(lstar));
+  return {(unsigned char)value, (unsigned char)value, (unsigned char)value, 255};
+}
+
+// Searches CAM16 J for the color with the requested L*; false if the
+// hue/chroma pair has no in-gamut color at that tone
+bool FindColorAtTone(double hue, double chroma, double tone, Color &out) {
+  double targetY = YFromLstar(tone);
+  double lo = 0.0;
+  double hi = 100.0;
+  double xyz[3];
+  for (int i = 0; i < 24; ++i) {
+    double j = (lo + hi) / 2.0;
+    Cam16ToXyz(j, chroma, hue, xyz);
+    if (xyz[1] < targetY)
+      lo = j;
+    else
+      hi = j;
+  }
+  Cam16ToXyz((lo + hi) / 2.0, chroma, hue, xyz);
+
+  double rgb[3];
+  XyzToLinearRgb(xyz, rgb);
+  // CAM16 grays are not exactly neutral, so near white even tiny chromas
+  // overshoot a channel; allow about one 8-bit step at each end
+  for (double channel : rgb) {
+    if (channel < -0.03 || channel > 101.0)
+      return false;
+  }
+  if (std::abs(LstarFromY(xyz[1]) - tone) > 0.5)
+    return false;
+
+  out = {(unsigned char)LinearToSrgb(rgb[0]), (unsigned char)LinearToSrgb(rgb[1]),
+         (unsigned char)LinearToSrgb(rgb[2]), 255};
+  return true;
+}
+
+} // namespace
+
+Hct HctFromColor(Color color) {
+  double r = SrgbToLinear(color.r);
+  double g = SrgbToLinear(color.g);
+  double b = SrgbToLinear(color.b);
+  double xyz[3] = {0.41233895 * r + 0.35762064 * g + 0.18051042 * b,
+                   0.2126 * r + 0.7152 * g + 0.0722 * b,
+                   0.01932141 * r + 0.11916382 * g + 0.95034478 * b};
+  Hct hct;
+  double j;
+  XyzToCam16(xyz, j, hct.chroma, hct.hue);
+  hct.tone = LstarFromY(xyz[1]);
+  return hct;
+}
+
+Color HctToColor(double hue, double chroma, double tone) {
+  if (chroma < 0.0001 || tone < 0.0001 || tone > 99.9999)
+    return GrayFromLstar(tone);
+
+  hue = std::fmod(hue, 360.0);
+  if (hue < 0.0)
+    hue += 360.0;
+
+  Color result;
+  if (FindColorAtTone(hue, chroma, tone, result))
+    return result;
+
+  // Out of gamut: bisect for the highest chroma that still fits
+  result = GrayFromLstar(tone);
+  double lo = 0.0;
+  double hi = chroma;
+  for (int i = 0; i < 16; ++i) {
+    double mid = (lo + hi) / 2.0;
+    Color candidate;
+    if (FindColorAtTone(hue, mid, tone, candidate)) {
+      lo = mid;
+      result = candidate;
+    } else {
+      hi = mid;
+    }
+  }
+  return result;
+}
+
+Color TonalPalette::Tone(int tone) {
+  tone = std::clamp(tone, 0, 100);
+  if (!solved_[tone]) {
+    tones_[tone] = HctToColor(hue_, chroma_, tone);
+    solved_[tone] = true;
+  }
+  return tones_[tone];
+}
+
+} // namespace raym3
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <array>
+#include <raylib.h>
+
+namespace raym3 {
+
+// HCT color space used by Material dynamic color: CAM16 hue and chroma
+// with CIE L* as tone (0 = black, 100 = white).
+struct Hct {
+  double hue;
+  double chroma;
+  double tone;
+};
+
+Hct HctFromColor(Color color);
+
+// Closest sRGB color to the given HCT; chroma is reduced until the color is
+// in gamut, hue and tone are kept
+Color HctToColor(double hue, double chroma, double tone);
+
+// All tones of one hue/chroma pair; each tone is solved once and memoized
+class TonalPalette {
+public:
+  TonalPalette() = default;
+  TonalPalette(double hue, double chroma) : hue_(hue), chroma_(chroma) {}
+
+  Color Tone(int tone);
+
+private:
+  double hue_ = 0.0;
+  double chroma_ = 0.0;
+  std::array<Color, 101> tones_{};
+  std::array<bool, 101> solved_{};
+};
+
+} // namespace raym3
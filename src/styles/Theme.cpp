@@ -1,11 +1,130 @@
 #include "raym3/styles/Theme.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <type_traits>
 
 namespace raym3 {
 
+namespace {
+
+constexpr uint32_t HashRoleName(std::string_view name) {
+  uint32_t hash = 2166136261u;
+  for (char c : name) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+struct RoleHash {
+  uint32_t hash;
+  ColorRole role;
+};
+
+// Role names hashed and sorted at compile time; a runtime lookup is one
+// hash, a binary search and a single strcmp to rule out collisions
+constexpr auto kRoleHashes = [] {
+  std::array<RoleHash, kColorRoleCount> table{};
+  for (size_t i = 0; i < kColorRoleCount; ++i) {
+    table[i] = {HashRoleName(kColorRoleNames[i]), static_cast<ColorRole>(i)};
+  }
+  std::sort(table.begin(), table.end(),
+            [](const RoleHash &a, const RoleHash &b) { return a.hash < b.hash; });
+  return table;
+}();
+
+bool ParseColorRole(const char *name, ColorRole &role) {
+  uint32_t hash = HashRoleName(name);
+  auto it = std::lower_bound(
+      kRoleHashes.begin(), kRoleHashes.end(), hash,
+      [](const RoleHash &entry, uint32_t value) { return entry.hash < value; });
+  if (it == kRoleHashes.end() || it->hash != hash)
+    return false;
+  if (std::strcmp(name, kColorRoleNames[static_cast<size_t>(it->role)]) != 0)
+    return false;
+  role = it->role;
+  return true;
+}
+
+// Schemes are blended as one flat byte array (32 RGBA colors), so the
+// per-frame crossfade is a single loop the compiler can vectorize
+static_assert(std::is_trivially_copyable_v<ColorScheme>);
+static_assert(sizeof(ColorScheme) == kColorRoleCount * sizeof(Color));
+constexpr size_t kSchemeBytes = sizeof(ColorScheme);
+
+// Material standard easing, cubic-bezier(0.2, 0, 0, 1), sampled at compile
+// time as 8.8 fixed-point weights (0..256) over 64 even steps of progress
+constexpr int kEaseSteps = 64;
+constexpr auto kEaseTable = [] {
+  std::array<uint16_t, kEaseSteps + 1> table{};
+  for (int i = 0; i <= kEaseSteps; ++i) {
+    double x = static_cast<double>(i) / kEaseSteps;
+    // Bisect the curve parameter whose x matches the progress
+    double lo = 0.0, hi = 1.0;
+    for (int iter = 0; iter < 40; ++iter) {
+      double t = (lo + hi) * 0.5;
+      double u = 1.0 - t;
+      double bx = 3.0 * u * u * t * 0.2 + t * t * t;
+      if (bx < x) {
+        lo = t;
+      } else {
+        hi = t;
+      }
+    }
+    double t = (lo + hi) * 0.5;
+    double u = 1.0 - t;
+    double by = 3.0 * u * t * t + t * t * t;
+    table[i] = static_cast<uint16_t>(by * 256.0 + 0.5);
+  }
+  return table;
+}();
+
+int EasedWeight(float progress) {
+  float position = std::clamp(progress, 0.0f, 1.0f) * kEaseSteps;
+  int index = std::min(static_cast<int>(position), kEaseSteps - 1);
+  float frac = position - static_cast<float>(index);
+  float a = kEaseTable[index];
+  float b = kEaseTable[index + 1];
+  return static_cast<int>(a + (b - a) * frac + 0.5f);
+}
+
+// Start bytes and per-byte deltas, computed once when a transition starts
+struct SchemeLerp {
+  std::array<uint8_t, kSchemeBytes> from;
+  std::array<int16_t, kSchemeBytes> delta;
+};
+
+SchemeLerp s_lerp;
+
+void BeginLerp(const ColorScheme &from, const ColorScheme &to) {
+  std::array<uint8_t, kSchemeBytes> target;
+  std::memcpy(s_lerp.from.data(), &from, kSchemeBytes);
+  std::memcpy(target.data(), &to, kSchemeBytes);
+  for (size_t i = 0; i < kSchemeBytes; ++i) {
+    s_lerp.delta[i] = static_cast<int16_t>(target[i] - s_lerp.from[i]);
+  }
+}
+
+void BlendLerp(int weight, ColorScheme &out) {
+  std::array<uint8_t, kSchemeBytes> blended;
+  for (size_t i = 0; i < kSchemeBytes; ++i) {
+    blended[i] =
+        static_cast<uint8_t>(s_lerp.from[i] + ((s_lerp.delta[i] * weight) >> 8));
+  }
+  std::memcpy(&out, blended.data(), kSchemeBytes);
+}
+
+} // namespace
+
 ColorScheme Theme::colorScheme_ = ColorScheme::Light();
+float Theme::transitionDuration_ = 0.0f;
+float Theme::transitionElapsed_ = 0.0f;
 TypographyScale Theme::typographyScale_;
 ShapeTokens Theme::shapeTokens_;
 bool Theme::darkMode_ = false;
+bool Theme::hasSeedColor_ = false;
+Color Theme::seedColor_ = {0, 0, 0, 0};
 bool Theme::initialized_ = false;
 
 void Theme::Initialize() {
@@ -16,6 +135,7 @@ void Theme::Initialize() {
   InitializeTypographyScale();
   InitializeShapeTokens();
   SetDarkMode(false);
+  PrewarmFonts();
 
   initialized_ = true;
 }
@@ -30,7 +150,57 @@ void Theme::Shutdown() {
 
 void Theme::SetDarkMode(bool isDarkMode) {
   darkMode_ = isDarkMode;
-  colorScheme_ = isDarkMode ? ColorScheme::Dark() : ColorScheme::Light();
+  if (hasSeedColor_) {
+    ApplyScheme(ColorScheme::FromSeed(seedColor_, isDarkMode));
+  } else {
+    ApplyScheme(isDarkMode ? ColorScheme::Dark() : ColorScheme::Light());
+  }
+}
+
+void Theme::ApplyScheme(const ColorScheme &target) {
+  if (!initialized_ || transitionDuration_ <= 0.0f) {
+    colorScheme_ = target;
+    transitionElapsed_ = transitionDuration_;
+    return;
+  }
+  // Starts from the currently displayed (possibly mid-fade) scheme, so a
+  // change during a transition retargets smoothly
+  BeginLerp(colorScheme_, target);
+  transitionElapsed_ = 0.0f;
+}
+
+void Theme::SetTransitionDuration(float seconds) {
+  // A fade in progress snaps to its target rather than being rescaled
+  if (IsTransitioning())
+    BlendLerp(256, colorScheme_);
+  transitionDuration_ = std::max(seconds, 0.0f);
+  transitionElapsed_ = transitionDuration_;
+}
+
+float Theme::GetTransitionDuration() { return transitionDuration_; }
+
+bool Theme::IsTransitioning() {
+  return transitionElapsed_ < transitionDuration_;
+}
+
+void Theme::UpdateTransition(float deltaTime) {
+  if (!IsTransitioning())
+    return;
+  transitionElapsed_ = std::min(transitionElapsed_ + deltaTime,
+                                transitionDuration_);
+  BlendLerp(EasedWeight(transitionElapsed_ / transitionDuration_),
+            colorScheme_);
+}
+
+void Theme::SetSeedColor(Color seedColor) {
+  hasSeedColor_ = true;
+  seedColor_ = seedColor;
+  SetDarkMode(darkMode_);
+}
+
+void Theme::ClearSeedColor() {
+  hasSeedColor_ = false;
+  SetDarkMode(darkMode_);
 }
 
 bool Theme::IsDarkMode() { return darkMode_; }
@@ -42,54 +212,10 @@ TypographyScale &Theme::GetTypographyScale() { return typographyScale_; }
 ShapeTokens &Theme::GetShapeTokens() { return shapeTokens_; }
 
 Color Theme::GetColor(const char *role) {
-  ColorScheme &scheme = GetColorScheme();
-
-  if (strcmp(role, "primary") == 0)
-    return scheme.primary;
-  if (strcmp(role, "onPrimary") == 0)
-    return scheme.onPrimary;
-  if (strcmp(role, "primaryContainer") == 0)
-    return scheme.primaryContainer;
-  if (strcmp(role, "onPrimaryContainer") == 0)
-    return scheme.onPrimaryContainer;
-  if (strcmp(role, "secondary") == 0)
-    return scheme.secondary;
-  if (strcmp(role, "onSecondary") == 0)
-    return scheme.onSecondary;
-  if (strcmp(role, "secondaryContainer") == 0)
-    return scheme.secondaryContainer;
-  if (strcmp(role, "onSecondaryContainer") == 0)
-    return scheme.onSecondaryContainer;
-  if (strcmp(role, "tertiary") == 0)
-    return scheme.tertiary;
-  if (strcmp(role, "onTertiary") == 0)
-    return scheme.onTertiary;
-  if (strcmp(role, "tertiaryContainer") == 0)
-    return scheme.tertiaryContainer;
-  if (strcmp(role, "onTertiaryContainer") == 0)
-    return scheme.onTertiaryContainer;
-  if (strcmp(role, "error") == 0)
-    return scheme.error;
-  if (strcmp(role, "onError") == 0)
-    return scheme.onError;
-  if (strcmp(role, "errorContainer") == 0)
-    return scheme.errorContainer;
-  if (strcmp(role, "onErrorContainer") == 0)
-    return scheme.onErrorContainer;
-  if (strcmp(role, "surface") == 0)
-    return scheme.surface;
-  if (strcmp(role, "onSurface") == 0)
-    return scheme.onSurface;
-  if (strcmp(role, "surfaceVariant") == 0)
-    return scheme.surfaceVariant;
-  if (strcmp(role, "onSurfaceVariant") == 0)
-    return scheme.onSurfaceVariant;
-  if (strcmp(role, "outline") == 0)
-    return scheme.outline;
-  if (strcmp(role, "outlineVariant") == 0)
-    return scheme.outlineVariant;
-
-  return scheme.surface;
+  ColorRole parsed;
+  if (role && ParseColorRole(role, parsed))
+    return colorScheme_.Get(parsed);
+  return colorScheme_.surface;
 }
 
 Color Theme::GetStateLayerColor(Color baseColor, ComponentState state) {
@@ -123,6 +249,25 @@ Font Theme::GetFont(float size, FontWeight weight, FontStyle style) {
   return FontManager::LoadFont(weight, style, static_cast<int>(size));
 }
 
+void Theme::PrewarmFonts(int workerCount) {
+  const TypographyScale &t = typographyScale_;
+  const float sizes[] = {t.displayLarge,  t.displayMedium,  t.displaySmall,
+                         t.headlineLarge, t.headlineMedium, t.headlineSmall,
+                         t.titleLarge,    t.titleMedium,    t.titleSmall,
+                         t.labelLarge,    t.labelMedium,    t.labelSmall,
+                         t.bodyLarge,     t.bodyMedium,     t.bodySmall};
+  const FontWeight weights[] = {FontWeight::Regular, FontWeight::Medium,
+                                FontWeight::Bold};
+
+  std::vector<FontPrewarmRequest> requests;
+  for (FontWeight weight : weights) {
+    for (float size : sizes) {
+      requests.push_back({weight, static_cast<int>(size)});
+    }
+  }
+  FontManager::PrewarmFonts(requests, workerCount);
+}
+
 float Theme::GetElevationShadow(int elevation) {
   const float shadows[] = {0.0f, 1.0f, 3.0f, 6.0f, 8.0f, 12.0f};
   if (elevation >= 0 && elevation < 6) {
@@ -0,0 +1,195 @@
+// Build-time tool: parses SVG icons with nanosvg and writes a C++ header with
+// the resulting bezier paths as constexpr tables (see src/rendering/IconPack.h).
+//
+// Usage: raym3_icon_pack <output.h> <icons-dir> <icon-list.txt>
+// The list holds one "variation/name" key per line; <icons-dir>/<key>.svg is
+// parsed for each. Missing files are skipped with a warning.
+
+#define NANOSVG_IMPLEMENTATION
+#include "external/nanosvg.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct PackedPath {
+  size_t firstPoint;
+  int pointCount;
+  bool closed;
+};
+
+struct PackedShape {
+  size_t firstPath;
+  size_t pathCount;
+  const NSVGshape *source;
+  size_t icon; // Index into the icon table
+};
+
+struct PackedIcon {
+  std::string key;
+  float width;
+  float height;
+  size_t firstShape;
+  size_t shapeCount;
+};
+
+// Gradients are not supported by the pack; they are baked to "no paint"
+int PaintType(const NSVGpaint &paint, const std::string &key) {
+  if (paint.type == NSVG_PAINT_COLOR || paint.type == NSVG_PAINT_NONE)
+    return paint.type;
+  std::cerr << "icon_pack: " << key << ": gradient paint dropped\n";
+  return NSVG_PAINT_NONE;
+}
+
+// Writes a float literal that round-trips exactly ("10.0f", "0.333333343f")
+void WriteFloat(std::ostream &out, float value) {
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%.9g", value);
+  std::string literal = buffer;
+  if (literal.find_first_of(".e") == std::string::npos)
+    literal += ".0";
+  out << literal << "f";
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  if (argc != 4) {
+    std::cerr << "usage: raym3_icon_pack <output.h> <icons-dir> <icon-list>\n";
+    return 1;
+  }
+  std::string outputPath = argv[1];
+  std::string iconsDir = argv[2];
+
+  std::vector<std::string> keys;
+  {
+    std::ifstream list(argv[3]);
+    std::string line;
+    while (std::getline(list, line)) {
+      if (!line.empty() && line.back() == '\r')
+        line.pop_back();
+      if (!line.empty())
+        keys.push_back(line);
+    }
+  }
+  // Entries must be sorted for the runtime binary search
+  std::sort(keys.begin(), keys.end());
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+  std::vector<NSVGimage *> images;
+  std::vector<PackedIcon> icons;
+  std::vector<PackedShape> shapes;
+  std::vector<PackedPath> paths;
+  std::vector<float> points;
+
+  for (const std::string &key : keys) {
+    std::string file = iconsDir + "/" + key + ".svg";
+    NSVGimage *image = nsvgParseFromFile(file.c_str(), "px", 96.0f);
+    if (!image) {
+      std::cerr << "icon_pack: skipping " << file << "\n";
+      continue;
+    }
+    images.push_back(image);
+
+    PackedIcon icon = {key, image->width, image->height, shapes.size(), 0};
+    for (NSVGshape *shape = image->shapes; shape; shape = shape->next) {
+      if (!(shape->flags & NSVG_FLAGS_VISIBLE))
+        continue;
+      if (shape->strokeDashCount > 0) {
+        std::cerr << "icon_pack: " << key << ": stroke dashes dropped\n";
+      }
+      PackedShape packed = {paths.size(), 0, shape, icons.size()};
+      for (NSVGpath *path = shape->paths; path; path = path->next) {
+        paths.push_back({points.size() / 2, path->npts, path->closed != 0});
+        points.insert(points.end(), path->pts, path->pts + path->npts * 2);
+        packed.pathCount++;
+      }
+      shapes.push_back(packed);
+      icon.shapeCount++;
+    }
+    icons.push_back(icon);
+  }
+
+  std::ofstream out(outputPath, std::ios::trunc);
+  if (!out) {
+    std::cerr << "icon_pack: cannot write " << outputPath << "\n";
+    return 1;
+  }
+
+  out << "// Generated by tools/icon_pack.cpp - do not edit\n"
+      << "#pragma once\n\n"
+      << "#include \"rendering/IconPack.h\"\n\n"
+      << "namespace raym3 {\n\n";
+
+  // Zero-length arrays are not allowed, so every table gets at least one
+  // element; entryCount keeps the real size.
+  out << "inline constexpr float kIconPackPoints[] = {";
+  for (size_t i = 0; i < points.size(); ++i) {
+    out << (i % 8 == 0 ? "\n    " : " ");
+    WriteFloat(out, points[i]);
+    out << ",";
+  }
+  if (points.empty())
+    out << "0.0f";
+  out << "\n};\n\n";
+
+  out << "inline constexpr IconPackPath kIconPackPaths[] = {\n";
+  for (const PackedPath &path : paths) {
+    out << "    {" << path.firstPoint << "u, " << path.pointCount << "u, "
+        << (path.closed ? 1 : 0) << "},\n";
+  }
+  if (paths.empty())
+    out << "    {0u, 0u, 0},\n";
+  out << "};\n\n";
+
+  out << "inline constexpr IconPackShape kIconPackShapes[] = {\n";
+  for (const PackedShape &packed : shapes) {
+    const NSVGshape &shape = *packed.source;
+    const std::string &key = icons[packed.icon].key;
+    out << "    {" << packed.firstPath << "u, " << packed.pathCount << "u, "
+        << shape.fill.color << "u, " << shape.stroke.color << "u, ";
+    WriteFloat(out, shape.opacity);
+    out << ", ";
+    WriteFloat(out, shape.strokeWidth);
+    out << ", ";
+    WriteFloat(out, shape.miterLimit);
+    out << ", " << PaintType(shape.fill, key) << ", "
+        << PaintType(shape.stroke, key) << ", " << (int)shape.fillRule << ", "
+        << (int)shape.strokeLineJoin << ", " << (int)shape.strokeLineCap
+        << ", " << (int)shape.paintOrder << "},\n";
+  }
+  if (shapes.empty())
+    out << "    {0u, 0u, 0u, 0u, 0.0f, 0.0f, 0.0f, 0, 0, 0, 0, 0, 0},\n";
+  out << "};\n\n";
+
+  out << "inline constexpr IconPackEntry kIconPackEntries[] = {\n";
+  for (const PackedIcon &icon : icons) {
+    out << "    {\"" << icon.key << "\", ";
+    WriteFloat(out, icon.width);
+    out << ", ";
+    WriteFloat(out, icon.height);
+    out << ", " << icon.firstShape << "u, " << icon.shapeCount << "u},\n";
+  }
+  if (icons.empty())
+    out << "    {\"\", 0.0f, 0.0f, 0u, 0u},\n";
+  out << "};\n\n";
+
+  out << "inline constexpr IconPack kEmbeddedIconPack = {\n"
+      << "    kIconPackEntries, " << icons.size() << "u, kIconPackShapes,\n"
+      << "    kIconPackPaths, kIconPackPoints};\n\n"
+      << "} // namespace raym3\n";
+
+  for (NSVGimage *image : images) {
+    nsvgDelete(image);
+  }
+
+  std::cout << "icon_pack: packed " << icons.size() << " icons, "
+            << shapes.size() << " shapes, " << points.size() / 2
+            << " points\n";
+  return 0;
+}